@@ -0,0 +1,111 @@
+/*
+  ccs811baseline.ino - Demo sketch keeping the CCS811 baseline in EEPROM across power cycles, via a CCS811Baseline.
+  Created 2026 oct 17
+*/
+
+
+#include <Wire.h>           // I2C library
+#include <EEPROM.h>         // EEPROM library (emulated in flash on ESP8266 and ESP32)
+#include "ccs811.h"         // CCS811 library
+#include "ccs811baseline.h" // CCS811 library: baseline persistence
+
+
+// Wiring for ESP8266 NodeMCU boards: VDD to 3V3, GND to GND, SDA to D2, SCL to D1, nWAKE to D3 (or GND)
+CCS811 ccs811(D3); // nWAKE on D3
+
+// Wiring for Nano: VDD to 3v3, GND to GND, SDA to A4, SCL to A5, nWAKE to 13
+//CCS811 ccs811(13); 
+
+
+// The baseline slots live in EEPROM bytes [EEPROM_BASE, EEPROM_BASE+EEPROM_SIZE): 12 slots of 5 bytes
+#define EEPROM_BASE 0
+#define EEPROM_SIZE 60
+
+
+// A CCS811Store on (a range of) the EEPROM
+class EepromStore : public CCS811Store {
+  public:
+    virtual int  size(void) { return EEPROM_SIZE; }
+    virtual bool read(int addr, uint8_t * buf, int count) { 
+      for( int i=0; i<count; i++ ) buf[i]= EEPROM.read(EEPROM_BASE+addr+i); 
+      return true; 
+    }
+    virtual bool write(int addr, const uint8_t * buf, int count) { 
+      #if defined(ESP8266) || defined(ESP32)
+        for( int i=0; i<count; i++ ) EEPROM.write(EEPROM_BASE+addr+i,buf[i]); 
+      #else
+        for( int i=0; i<count; i++ ) EEPROM.update(EEPROM_BASE+addr+i,buf[i]); // Only writes changed bytes
+      #endif
+      return true; 
+    }
+    virtual bool commit(void) { 
+      #if defined(ESP8266) || defined(ESP32)
+        return EEPROM.commit(); 
+      #else
+        return true;
+      #endif
+    }
+};
+
+
+EepromStore store;
+CCS811Baseline baseline(&ccs811, &store);
+
+
+void setup() {
+  // Enable serial
+  Serial.begin(115200);
+  Serial.println("");
+  Serial.println("setup: Starting CCS811 baseline demo");
+  Serial.print("setup: ccs811 lib  version: "); Serial.println(CCS811_VERSION);
+
+  // Enable EEPROM (emulation needs a size on ESP)
+  #if defined(ESP8266) || defined(ESP32)
+    EEPROM.begin(EEPROM_BASE+EEPROM_SIZE);
+  #endif
+
+  // Enable I2C
+  Wire.begin(); 
+  
+  // Enable CCS811 (resume it when it kept running during a reboot of the host)
+  ccs811.set_i2cdelay(50); // Needed for ESP8266 because it doesn't handle I2C clock stretch correctly
+  if( !ccs811.begin_warm() ) Serial.println("setup: CCS811 begin FAILED");
+  bool resumed= ccs811.get_mode()!=CCS811_MODE_IDLE;
+  if( resumed ) Serial.println("setup: CCS811 resumed");
+  else if( !ccs811.start(CCS811_MODE_1SEC) ) Serial.println("setup: CCS811 start FAILED");
+
+  // Start the baseline manager (it restores the stored baseline after 20 minutes, unless the CCS811 was resumed: its own is newer)
+  baseline.begin(!resumed);
+  uint16_t b;
+  if( baseline.stored(&b) ) { Serial.print("setup: stored baseline "); Serial.println(b,HEX); }
+  else Serial.println("setup: no stored baseline");
+}
+
+
+void loop() {
+  // Restore and save the baseline when due
+  int res= baseline.poll();
+  if( res==CCS811BASELINE_RESTORED ) Serial.println("loop: baseline restored");
+  if( res==CCS811BASELINE_SAVED ) Serial.println("loop: baseline saved");
+  if( res==CCS811BASELINE_FAILED ) Serial.println("loop: baseline FAILED");
+
+  // Read
+  uint16_t eco2, etvoc, errstat, raw;
+  ccs811.read(&eco2,&etvoc,&errstat,&raw); 
+  if( errstat==CCS811_ERRSTAT_OK ) { 
+    Serial.print("CCS811: ");
+    Serial.print("eco2=");  Serial.print(eco2);     Serial.print(" ppm  ");
+    Serial.print("etvoc="); Serial.print(etvoc);    Serial.print(" ppb  ");
+    Serial.println();
+  } else if( errstat==CCS811_ERRSTAT_OK_NODATA ) {
+    Serial.println("CCS811: waiting for (new) data");
+  } else if( errstat & CCS811_ERRSTAT_I2CFAIL ) { 
+    Serial.println("CCS811: I2C error");
+  } else {
+    Serial.print("CCS811: errstat="); Serial.print(errstat,HEX); 
+    Serial.print("="); Serial.println( ccs811.errstat_str(errstat) ); 
+  }
+ 
+  // Wait
+  delay(1000); 
+}
@@ -36,10 +36,12 @@ void setup() {
   bool ok= ccs811.begin();
   if( !ok ) Serial.println("setup: CCS811 begin FAILED");
 
-  // Print CCS811 versions
+  // Print CCS811 versions (in one wake session: nWAKE is pulled low once for all three)
+  ccs811.wake_begin();
   Serial.print("setup: hardware    version: "); Serial.println(ccs811.hardware_version(),HEX);
   Serial.print("setup: bootloader  version: "); Serial.println(ccs811.bootloader_version(),HEX);
   Serial.print("setup: application version: "); Serial.println(ccs811.application_version(),HEX);
+  ccs811.wake_end();
   
   // Start measuring
   ok= ccs811.start(CCS811_MODE_1SEC);
@@ -41,6 +41,9 @@ void setup() {
   Serial.print("setup: CCS811 start ");
   ok= ccs811.start(CCS811_MODE_1SEC);
   if( ok ) Serial.println("ok"); else Serial.println("FAILED");
+
+  // Only write ENV_DATA when T moved 0.5C, H moved 1%RH, or after a minute
+  ccs811.set_envdata_deadband(256,512,60000);
 }
 
 
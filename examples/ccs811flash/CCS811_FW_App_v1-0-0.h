@@ -310,3 +310,8 @@ const uint8_t image_data[] PROGMEM = {
   0x0f, 0xfb, 0x5e, 0x3d, 0xb7, 0x61, 0xbf, 0x36,   0x1d, 0x97, 0xcd, 0x4e, 0x6a, 0x87, 0xa2, 0x86, 
   0x30, 0x2f, 0xd4, 0x02, 0xcb, 0x40, 0xec, 0x91,   
 };
+
+// Container header for CCS811::flash_image(): 'C811', format 1, flags 0, version 1000, size 4872, CRC-16 3696
+const uint8_t image_header[] PROGMEM = {
+  0x43, 0x38, 0x31, 0x31, 0x01, 0x00, 0x10, 0x00, 0x13, 0x08, 0x36, 0x96, 
+};
@@ -325,3 +325,8 @@ const uint8_t image_data[] PROGMEM = {
   0xdd, 0x59, 0xef, 0xbb, 0xb4, 0x29, 0x1c, 0xdb,   0x9d, 0xf9, 0x5c, 0x81, 0x2c, 0x46, 0x75, 0x7e, 
   0xab, 0x17, 0x7a, 0x1c, 0x49, 0x84, 0x57, 0xcf,   0x87, 0xc2, 0x5e, 0xec, 0x24, 0x46, 0x20, 0xfa, 
 };
+
+// Container header for CCS811::flash_image(): 'C811', format 1, flags 0, version 2000, size 5120, CRC-16 7dd3
+const uint8_t image_header[] PROGMEM = {
+  0x43, 0x38, 0x31, 0x31, 0x01, 0x00, 0x20, 0x00, 0x14, 0x00, 0x7d, 0xd3, 
+};
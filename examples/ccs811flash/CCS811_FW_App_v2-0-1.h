@@ -325,3 +325,8 @@ const uint8_t image_data[] PROGMEM = {
   0x3c, 0x73, 0xa6, 0x93, 0x08, 0xaa, 0xea, 0xe4,   0x80, 0xbb, 0x5a, 0x3d, 0x3a, 0x7c, 0x0f, 0x9c, 
   0x30, 0x2f, 0xd4, 0x02, 0xcb, 0x40, 0xec, 0x91,   
 };
+
+// Container header for CCS811::flash_image(): 'C811', format 1, flags 0, version 2001, size 5112, CRC-16 96cc
+const uint8_t image_header[] PROGMEM = {
+  0x43, 0x38, 0x31, 0x31, 0x01, 0x00, 0x20, 0x01, 0x13, 0xf8, 0x96, 0xcc, 
+};
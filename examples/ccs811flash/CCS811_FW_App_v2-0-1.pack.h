@@ -0,0 +1,153 @@
+// Hex dump of 'CCS811_FW_App_v2-0-1.bin' created at 2026-10-17 00:45:02.504308
+
+#include <stdint.h>
+
+const char * packed_name="CCS811_FW_App_v2-0-1.bin";
+const int packed_imagesize=5112;
+// 'CCS811_FW_App_v2-0-1.bin' packed against 'CCS811_FW_App_v2-0-0.bin': 2209 of 5112 bytes (43.2%), see ccs811unpack.h
+const uint8_t packed_data[] PROGMEM = {
+  0x07, 0x70, 0x4e, 0xf4, 0x1e, 0x2d, 0xa7, 0x8d,   0x4f, 0x84, 0x00, 0x08, 0x1f, 0xb0, 0x0e, 0x5a, 
+  0x64, 0x8c, 0x35, 0xb8, 0x89, 0x81, 0xd4, 0xac,   0xb3, 0x8f, 0xa3, 0x52, 0x9b, 0x8a, 0x8f, 0xa0, 
+  0xa4, 0x7e, 0x19, 0x76, 0x3e, 0xb2, 0x49, 0xb9,   0x52, 0xe5, 0xf6, 0x1e, 0x69, 0x84, 0x00, 0x30, 
+  0x07, 0x2d, 0x36, 0x35, 0x2e, 0x99, 0xd1, 0x44,   0x1b, 0xbc, 0x00, 0x40, 0x07, 0x99, 0xc3, 0xfb, 
+  0x14, 0xcd, 0x77, 0x62, 0x96, 0x84, 0x00, 0x88,   0x07, 0xb3, 0x0f, 0x30, 0x37, 0xb6, 0x2e, 0xc7, 
+  0x39, 0xff, 0x00, 0x98, 0x81, 0x01, 0x1b, 0x07,   0x9b, 0x31, 0xa7, 0x87, 0xad, 0x77, 0x1e, 0x17, 
+  0xcc, 0x01, 0x28, 0x07, 0x0d, 0xb7, 0x20, 0x24,   0xa1, 0xf5, 0x45, 0xdc, 0xcc, 0x01, 0x80, 0x07, 
+  0x5b, 0x0c, 0x9e, 0xe1, 0x01, 0xbc, 0x28, 0xbd,   0x9c, 0x01, 0xd8, 0x07, 0xcc, 0x4e, 0xa2, 0xb5, 
+  0xeb, 0x2c, 0xac, 0xcc, 0xff, 0x02, 0x00, 0xc9,   0x02, 0x83, 0x07, 0x6f, 0xdf, 0xfb, 0xc6, 0x12, 
+  0xc1, 0xda, 0xd5, 0xff, 0x02, 0xd8, 0xff, 0x03,   0x5b, 0xff, 0x03, 0xde, 0xff, 0x04, 0x61, 0xff, 
+  0x04, 0xe4, 0xff, 0x05, 0x67, 0xff, 0x05, 0xea,   0xa7, 0x06, 0x6d, 0x0f, 0x91, 0x81, 0x48, 0x5e, 
+  0x3c, 0x43, 0x5e, 0xbb, 0x51, 0x86, 0x26, 0x9e,   0x29, 0x6f, 0x5e, 0x57, 0x8c, 0x06, 0xa8, 0x07, 
+  0x8a, 0x5a, 0xf0, 0x3e, 0x8a, 0x2b, 0x4a, 0xd2,   0x84, 0x06, 0xc0, 0x06, 0x92, 0x9d, 0xb5, 0x40, 
+  0x03, 0x8d, 0x74, 0x85, 0x06, 0xcf, 0x07, 0x2b,   0x0d, 0x78, 0x50, 0x3a, 0x35, 0x45, 0x94, 0x84, 
+  0x06, 0xe0, 0x07, 0xeb, 0xdc, 0xf3, 0x11, 0xee,   0xec, 0x33, 0x5b, 0x8c, 0x06, 0xf0, 0x0f, 0x1e, 
+  0x2e, 0xec, 0x56, 0x9b, 0x6c, 0x73, 0xa7, 0xe6,   0xba, 0xbc, 0xc8, 0xe6, 0x71, 0x6d, 0x39, 0x8c, 
+  0x07, 0x10, 0x07, 0xcb, 0xd6, 0xbf, 0x69, 0x2f,   0x1b, 0x68, 0x26, 0xbc, 0x07, 0x28, 0x17, 0x8b, 
+  0x80, 0x30, 0xb8, 0x30, 0xa8, 0x52, 0x1d, 0x98,   0xac, 0xa1, 0xf0, 0xfe, 0xd3, 0x40, 0x47, 0x63, 
+  0x72, 0xe4, 0x79, 0x34, 0xa5, 0x96, 0x7c, 0xb4,   0x07, 0x80, 0x7f, 0xb9, 0xcd, 0xb3, 0xd1, 0x50, 
+  0x98, 0xe7, 0xfc, 0x14, 0x0c, 0x7c, 0xa4, 0x51,   0x9c, 0xdb, 0xae, 0xc5, 0xf1, 0x97, 0x9c, 0xcf, 
+  0xa7, 0xb6, 0x7c, 0x0b, 0x59, 0x3e, 0x2f, 0xf6,   0x4c, 0x24, 0xc4, 0x3a, 0x35, 0xed, 0xc4, 0xa5, 
+  0xc8, 0xcd, 0x45, 0x15, 0x21, 0x3c, 0x1b, 0xc0,   0x0b, 0x01, 0x22, 0x84, 0x8b, 0x94, 0x56, 0x82, 
+  0xa9, 0xbc, 0x03, 0xc5, 0x4f, 0x12, 0xb3, 0xe0,   0xa4, 0xe1, 0xb9, 0x8d, 0x10, 0x66, 0x3e, 0xeb, 
+  0x61, 0xc9, 0x21, 0x79, 0xc1, 0xc3, 0x26, 0x5e,   0xc5, 0xb0, 0x5f, 0xa2, 0x87, 0x76, 0xae, 0x35, 
+  0x0a, 0x54, 0xd6, 0x09, 0x9f, 0x0a, 0x2e, 0x98,   0xff, 0xb5, 0x98, 0xff, 0x85, 0xd9, 0x00, 0x6d, 
+  0xf3, 0x05, 0x26, 0x8c, 0x63, 0xef, 0x69, 0x5f,   0x5c, 0x82, 0x78, 0xa2, 0x75, 0x42, 0x5f, 0x6f, 
+  0x73, 0x83, 0x5b, 0xc2, 0x2f, 0x02, 0x72, 0xf4,   0xf6, 0x7b, 0x2f, 0x7f, 0xc5, 0xc0, 0xb5, 0x84, 
+  0xbc, 0x46, 0x30, 0xfd, 0xf7, 0xa1, 0x10, 0xbf,   0x36, 0x8c, 0x90, 0x94, 0x66, 0x07, 0x1f, 0x57, 
+  0xb4, 0x61, 0xb5, 0xb1, 0x8a, 0x98, 0x9e, 0x5c,   0x0a, 0xb6, 0x53, 0xb5, 0x6c, 0x01, 0xa8, 0xec, 
+  0xe1, 0xc3, 0x50, 0x21, 0xbd, 0x6c, 0xe4, 0x36,   0xc9, 0x1c, 0x9d, 0x4a, 0x36, 0xfa, 0x21, 0x60, 
+  0x96, 0x59, 0x6f, 0x2d, 0xb8, 0x75, 0x8e, 0x45,   0x03, 0x8c, 0xc5, 0xee, 0x0c, 0x30, 0x60, 0x82, 
+  0x99, 0x5b, 0x4b, 0x79, 0xcd, 0x68, 0xb3, 0xc0,   0xe3, 0x1a, 0x6b, 0x34, 0x3d, 0x95, 0x11, 0x06, 
+  0x56, 0x95, 0x29, 0x61, 0x7b, 0x5e, 0x86, 0xa9,   0x1a, 0x5f, 0x4d, 0x98, 0x68, 0x9c, 0x8d, 0x10, 
+  0x91, 0x3c, 0xbf, 0x4c, 0x0d, 0xbc, 0x8b, 0xf7,   0x8b, 0x85, 0x0c, 0xf6, 0x6e, 0x7e, 0x82, 0x68, 
+  0x5c, 0x7a, 0xf2, 0x57, 0x87, 0xd9, 0xaf, 0xe5,   0x0f, 0xf1, 0xb9, 0xf7, 0x7f, 0x7e, 0xef, 0xc4, 
+  0x74, 0xbd, 0x01, 0x30, 0x7e, 0xf4, 0x93, 0x26,   0x08, 0x6e, 0xe9, 0xd7, 0x4e, 0x14, 0x31, 0xe9, 
+  0x9d, 0xb3, 0xbf, 0xeb, 0x20, 0x86, 0x10, 0x2c,   0x0d, 0x94, 0xe9, 0xb3, 0x1d, 0xa5, 0x54, 0x95, 
+  0x2b, 0x36, 0x0b, 0x90, 0x6a, 0xc7, 0x86, 0xbf,   0x09, 0x66, 0x12, 0x00, 0xb3, 0x3b, 0x2d, 0xf1, 
+  0x10, 0x00, 0x9b, 0x94, 0xeb, 0x06, 0x85, 0x41,   0x3c, 0x75, 0x0f, 0x00, 0x75, 0x28, 0x3b, 0xf8, 
+  0x55, 0x5c, 0x74, 0xaa, 0x5b, 0xcf, 0x88, 0x54,   0x66, 0xfb, 0x97, 0x9f, 0x23, 0xbc, 0x79, 0x63, 
+  0x57, 0x75, 0x58, 0xc4, 0x9b, 0x39, 0xe9, 0x3b,   0x34, 0x33, 0x1c, 0xcc, 0x75, 0x1b, 0x3e, 0xb9, 
+  0xb7, 0x50, 0xa9, 0xbf, 0x90, 0xc5, 0xb9, 0xe3,   0x31, 0x23, 0x52, 0xb9, 0xcd, 0xda, 0x52, 0x6f, 
+  0xa4, 0x1e, 0x6f, 0x1d, 0x01, 0x92, 0x0a, 0x2b,   0x97, 0x83, 0x07, 0x03, 0x87, 0x7f, 0x0b, 0x71, 
+  0xf8, 0x23, 0x23, 0x4a, 0x23, 0x9f, 0xf6, 0xe3,   0xb1, 0x74, 0xd1, 0x7c, 0x41, 0x58, 0xfa, 0x4b, 
+  0xb2, 0x58, 0xbf, 0x00, 0x4c, 0xc1, 0x9a, 0xbd,   0x17, 0xaf, 0x77, 0xee, 0x27, 0x63, 0x2a, 0xc0, 
+  0xd6, 0x81, 0xce, 0xba, 0x66, 0x00, 0x0f, 0x69,   0xea, 0xd2, 0x25, 0xf6, 0xcc, 0xd8, 0x5a, 0xda, 
+  0x5e, 0xd0, 0x37, 0x11, 0x56, 0xec, 0xb2, 0x04,   0x99, 0xbd, 0x35, 0x9f, 0xa6, 0xd9, 0x2e, 0x4d, 
+  0xa7, 0x81, 0x80, 0x14, 0x6e, 0xe6, 0xb7, 0xc0,   0xfc, 0x1c, 0xfa, 0x4c, 0x5a, 0xbe, 0x33, 0x2e, 
+  0x81, 0xb7, 0xd2, 0x16, 0xcc, 0x84, 0x57, 0x72,   0x9a, 0x0c, 0xa6, 0x1e, 0xc7, 0xc5, 0x64, 0x18, 
+  0x66, 0xa0, 0x3e, 0xf7, 0x9b, 0xc6, 0xd9, 0x9d,   0xeb, 0x4f, 0xaa, 0x2b, 0x89, 0xf3, 0xd2, 0x02, 
+  0x7f, 0x7c, 0xd7, 0xf5, 0x00, 0x2c, 0x92, 0xa6,   0x51, 0x5b, 0xe4, 0x43, 0x71, 0xa4, 0x7f, 0xaf, 
+  0x22, 0xa1, 0x0c, 0xec, 0x51, 0xff, 0x72, 0xbe,   0x1f, 0x48, 0xa5, 0xd6, 0x3b, 0x73, 0x85, 0x2a, 
+  0xa2, 0xe2, 0x1e, 0xca, 0xe0, 0x08, 0xe3, 0xa3,   0x97, 0xe3, 0xfe, 0x9b, 0xe1, 0x8a, 0xa1, 0xb4, 
+  0x3f, 0x81, 0xd7, 0x34, 0x59, 0x65, 0x46, 0xa8,   0x6d, 0x99, 0x07, 0x73, 0xa4, 0x18, 0x81, 0x49, 
+  0x42, 0xf3, 0x83, 0xe0, 0x81, 0x79, 0xe4, 0x3f,   0xc6, 0x9b, 0x5e, 0x63, 0x43, 0x0c, 0xfa, 0x27, 
+  0x62, 0x63, 0x5a, 0x5a, 0x7a, 0xbc, 0xa4, 0x62,   0x2e, 0x09, 0x9f, 0xf0, 0xf9, 0x1b, 0x56, 0x09, 
+  0x07, 0xa5, 0x18, 0x53, 0x7e, 0x8a, 0x7b, 0xa2,   0x2f, 0xc1, 0xf7, 0x9b, 0xc2, 0x8a, 0x8c, 0x15, 
+  0x09, 0xb9, 0xfd, 0x6e, 0x5e, 0x4f, 0x47, 0x9c,   0x30, 0x25, 0x1d, 0x35, 0x9a, 0x17, 0x71, 0xf2, 
+  0x77, 0x81, 0x6b, 0x30, 0x10, 0x26, 0xa6, 0x81,   0x35, 0x5d, 0xd0, 0x96, 0xe1, 0x7b, 0x7d, 0x7f, 
+  0x9e, 0x8c, 0x5c, 0x28, 0x3a, 0x9d, 0xd9, 0xe6,   0x4a, 0xe6, 0xce, 0x08, 0x9f, 0xb6, 0x3f, 0xae, 
+  0x0a, 0x80, 0xf9, 0x90, 0x62, 0x9d, 0x04, 0xf0,   0x38, 0x54, 0x77, 0x3e, 0x22, 0xc2, 0xe1, 0xf4, 
+  0xa5, 0xb3, 0x88, 0x4a, 0xc9, 0xd3, 0xdc, 0x75,   0xb8, 0x93, 0x6f, 0x75, 0x6f, 0x6b, 0x6e, 0x3c, 
+  0x64, 0xd2, 0x3a, 0x6e, 0x7b, 0x3c, 0x23, 0x39,   0x67, 0x78, 0x94, 0x92, 0x5d, 0x87, 0x38, 0x11, 
+  0x7c, 0x99, 0x97, 0x5f, 0x2f, 0xfe, 0x4f, 0x4d,   0x2e, 0x1c, 0xb6, 0xc2, 0xb2, 0x2d, 0x35, 0x70, 
+  0xde, 0xc9, 0x6c, 0xc5, 0xd9, 0x35, 0xbb, 0xd5,   0xdb, 0xfa, 0x5a, 0xf8, 0xe0, 0xf0, 0x82, 0x33, 
+  0x3d, 0x87, 0xf6, 0x54, 0xb3, 0x25, 0x36, 0xd8,   0x5d, 0x5f, 0x3c, 0x96, 0x2f, 0xd8, 0x8a, 0x80, 
+  0x9a, 0x69, 0x63, 0xc9, 0x52, 0x00, 0x36, 0x7a,   0x6e, 0x25, 0xa4, 0x1b, 0x8b, 0xb2, 0xf6, 0x49, 
+  0x7f, 0xcd, 0x93, 0x9e, 0x8c, 0x50, 0xd5, 0x2d,   0x5e, 0x85, 0x95, 0x69, 0xc7, 0x53, 0x59, 0x73, 
+  0x3d, 0xd2, 0xfb, 0x40, 0xea, 0xbc, 0x74, 0xe0,   0x21, 0x79, 0x85, 0x95, 0x57, 0xcd, 0x59, 0x10, 
+  0xd2, 0xd2, 0xdd, 0x05, 0x98, 0x79, 0xe0, 0x0c,   0x92, 0xf5, 0xcf, 0x0b, 0xa6, 0xe2, 0x0c, 0xe3, 
+  0x55, 0xd7, 0xd2, 0xf3, 0x12, 0xa7, 0xf2, 0xc8,   0x1c, 0x70, 0x21, 0x5b, 0x8b, 0x4d, 0x9c, 0xcd, 
+  0x28, 0x01, 0xf1, 0x6a, 0x0c, 0xb1, 0xb5, 0x55,   0x98, 0xf4, 0x0b, 0xfa, 0x40, 0xd9, 0xe5, 0x7d, 
+  0xff, 0x0d, 0xa3, 0x46, 0x04, 0xba, 0x28, 0xa6,   0x78, 0x8a, 0xe1, 0xe3, 0xcf, 0xd9, 0x7b, 0x62, 
+  0x31, 0x69, 0xa5, 0xb3, 0x89, 0xda, 0xe6, 0x7b,   0xe3, 0x5d, 0x6a, 0x8c, 0xb4, 0x85, 0x08, 0x74, 
+  0x1a, 0x7f, 0xd3, 0x49, 0xf6, 0x31, 0xf0, 0x5e,   0xf1, 0x46, 0x54, 0xc2, 0x09, 0x30, 0xa9, 0xec, 
+  0xab, 0x7f, 0xb4, 0xbf, 0xe9, 0x5e, 0x5b, 0xd3,   0x45, 0x45, 0x65, 0x78, 0x95, 0xc5, 0x63, 0xbc, 
+  0xc0, 0x2d, 0x2a, 0x6a, 0xcc, 0xf1, 0xdb, 0x9e,   0xe8, 0x42, 0x66, 0x83, 0x39, 0x11, 0x38, 0xcf, 
+  0x3f, 0xab, 0x6c, 0x82, 0x86, 0xd7, 0x6b, 0x73,   0x4e, 0x4a, 0x50, 0x99, 0xf1, 0xf1, 0x56, 0xb5, 
+  0x75, 0x50, 0xf4, 0x08, 0x0b, 0x41, 0x7d, 0x1d,   0x21, 0xc6, 0xa2, 0xde, 0x52, 0x4b, 0xc2, 0xa9, 
+  0x6b, 0x5b, 0x13, 0x5b, 0xee, 0xdf, 0x7e, 0xd1,   0xef, 0xe6, 0x6c, 0xb6, 0xff, 0x1d, 0x54, 0xcb, 
+  0xdf, 0x3f, 0xe3, 0x48, 0xbb, 0xef, 0x42, 0x8f,   0x3a, 0x79, 0x37, 0x09, 0x32, 0x1f, 0xc7, 0xad, 
+  0x2b, 0x74, 0x97, 0x76, 0x1a, 0x6d, 0x23, 0x61,   0x2a, 0x93, 0xe3, 0xdb, 0x14, 0x6d, 0x5e, 0x39, 
+  0x56, 0xe7, 0x42, 0x0d, 0x6d, 0x5e, 0x9d, 0xc9,   0xd4, 0x50, 0x9f, 0x19, 0xfd, 0x7f, 0x63, 0x39, 
+  0xda, 0xb1, 0x7f, 0xd1, 0x73, 0xb4, 0x2b, 0x94,   0x94, 0xc3, 0xf1, 0x63, 0xfb, 0x97, 0xd0, 0x15, 
+  0x05, 0xa1, 0x23, 0x45, 0x37, 0x89, 0x2a, 0x29,   0x4a, 0xa0, 0x55, 0x74, 0x9f, 0x92, 0x6e, 0xd5, 
+  0x4e, 0xc8, 0xf3, 0x0e, 0x20, 0xed, 0xd5, 0xf1,   0x02, 0xfc, 0x89, 0xe0, 0xb3, 0xbe, 0x01, 0x4f, 
+  0xee, 0x87, 0xb1, 0xb6, 0x16, 0x09, 0x79, 0x50,   0x2d, 0xfc, 0xf9, 0x1e, 0x1b, 0x1c, 0xf4, 0x05, 
+  0x1f, 0xa8, 0xd1, 0xfb, 0xe8, 0xdb, 0x84, 0x2d,   0xb3, 0xf6, 0x96, 0x69, 0xd8, 0x95, 0xc5, 0x2d, 
+  0x52, 0xe2, 0x9d, 0xb4, 0xc1, 0x32, 0x45, 0x0f,   0xec, 0xfb, 0xbc, 0x8c, 0xba, 0xec, 0x90, 0x52, 
+  0xc6, 0x9c, 0xce, 0x06, 0xf7, 0x38, 0x48, 0x36,   0x03, 0x85, 0x95, 0xb0, 0xc8, 0x0d, 0xd7, 0xef, 
+  0xd8, 0xd1, 0x62, 0x2e, 0xf2, 0x8e, 0x50, 0x75,   0x02, 0xdf, 0x14, 0x7c, 0x91, 0x5a, 0x7d, 0xd2, 
+  0x15, 0xa5, 0x2c, 0x7f, 0x87, 0xb8, 0xdf, 0x91,   0xe1, 0x75, 0x07, 0x35, 0xa4, 0xdb, 0xb0, 0xd3, 
+  0x47, 0x32, 0x05, 0x93, 0x79, 0x9d, 0x60, 0xce,   0xcd, 0xc3, 0xc2, 0x0d, 0x3b, 0x42, 0x2d, 0x1b, 
+  0xff, 0x3d, 0xcb, 0x86, 0xe3, 0x4b, 0x5b, 0x35,   0x98, 0x71, 0xe7, 0xfc, 0x32, 0xc9, 0x09, 0xd2, 
+  0xa4, 0x5f, 0x5b, 0xdb, 0x6e, 0x90, 0xde, 0xbf,   0x31, 0xbb, 0x1d, 0xfd, 0x01, 0x08, 0xe5, 0x0c, 
+  0x6d, 0x52, 0x86, 0xac, 0xd1, 0xfe, 0x95, 0x6e,   0x31, 0x7f, 0x45, 0xa1, 0x93, 0x18, 0xd9, 0x55, 
+  0xc2, 0xc6, 0xc0, 0x09, 0xbc, 0xbf, 0xc2, 0x38,   0x51, 0x23, 0x06, 0x9c, 0x2a, 0x79, 0xc3, 0xa7, 
+  0xf4, 0x84, 0xa6, 0x6b, 0x09, 0x52, 0xfc, 0x8b,   0x3c, 0xad, 0xcb, 0xff, 0x58, 0xa0, 0x61, 0x2b, 
+  0xd3, 0xcb, 0x96, 0x97, 0x50, 0x4e, 0x3a, 0x1f,   0x20, 0x9f, 0x79, 0x9b, 0x92, 0x13, 0xcd, 0x1c, 
+  0xc9, 0xdf, 0x62, 0x4d, 0x7f, 0x44, 0x92, 0x77,   0x47, 0xae, 0xa5, 0x3f, 0xf1, 0x68, 0x52, 0x28, 
+  0xf8, 0xd2, 0x58, 0x83, 0xe3, 0xe1, 0x14, 0x0c,   0x85, 0xff, 0x0e, 0x3e, 0x54, 0xe5, 0xf1, 0xe0, 
+  0xad, 0xb7, 0x31, 0x17, 0xe8, 0x2f, 0x1f, 0xf1,   0x3c, 0x82, 0x9c, 0xf1, 0x3c, 0x81, 0xf2, 0x6c, 
+  0x36, 0x15, 0xc6, 0xf0, 0xd3, 0xaf, 0x4d, 0xd6,   0xaa, 0x46, 0x2f, 0x75, 0x9d, 0x8f, 0x4e, 0xac, 
+  0x10, 0x0d, 0x5c, 0x7d, 0x4f, 0x9e, 0x35, 0x87,   0xd8, 0xef, 0x28, 0xf1, 0x9d, 0xd2, 0x6a, 0xc0, 
+  0xb5, 0x2b, 0xa3, 0xbf, 0xa2, 0x59, 0xc6, 0xac,   0x7b, 0xe9, 0x82, 0x46, 0x5c, 0x78, 0xed, 0x44, 
+  0x97, 0x02, 0x1d, 0x4e, 0x10, 0xf6, 0xfd, 0x2a,   0x81, 0xd2, 0x87, 0xf7, 0x1c, 0x4d, 0x6b, 0x93, 
+  0x62, 0x92, 0x15, 0xcf, 0x31, 0xc3, 0x56, 0x6f,   0x44, 0x67, 0x47, 0x11, 0xce, 0x98, 0x2f, 0x72, 
+  0x1d, 0x5d, 0x75, 0xa4, 0xd4, 0x7f, 0x7c, 0x69,   0x4d, 0x08, 0xed, 0x6c, 0x89, 0x02, 0xc9, 0x0b, 
+  0x3f, 0x2a, 0x56, 0xdd, 0x30, 0x7c, 0xfd, 0x4b,   0xbb, 0x36, 0xb5, 0x16, 0xa0, 0x7f, 0xc5, 0x70, 
+  0xe5, 0x8c, 0x1a, 0x44, 0x3e, 0xfc, 0xd7, 0x08,   0x44, 0x13, 0x96, 0xad, 0x52, 0x5a, 0xa7, 0xb9, 
+  0xd6, 0x7d, 0x01, 0x54, 0x07, 0x9f, 0x36, 0x0c,   0x30, 0xe3, 0xe7, 0xac, 0x45, 0x60, 0x84, 0x0e, 
+  0x35, 0x5c, 0x90, 0x94, 0x7c, 0x0c, 0x76, 0xb4,   0xe4, 0x65, 0x2c, 0x3c, 0x60, 0x89, 0x34, 0xf2, 
+  0x4f, 0x60, 0xfb, 0xba, 0xff, 0x22, 0xd5, 0x24,   0x46, 0xfc, 0x80, 0x9f, 0x14, 0xcb, 0x50, 0x8e, 
+  0x64, 0xc5, 0x9b, 0xb2, 0xc0, 0x7e, 0xa6, 0xed,   0xad, 0xb1, 0x12, 0x9b, 0xd7, 0xef, 0x4f, 0x33, 
+  0x66, 0x3c, 0x6e, 0xc3, 0x68, 0xba, 0x9e, 0xbf,   0x7f, 0xd9, 0x5d, 0xbb, 0x2e, 0xa6, 0x8f, 0xbf, 
+  0x57, 0x02, 0xc6, 0x25, 0x88, 0x1b, 0x47, 0xa5,   0x7c, 0x3c, 0x46, 0xe4, 0xc1, 0x2e, 0x31, 0x86, 
+  0xb4, 0xc1, 0x4f, 0xcb, 0x6f, 0x57, 0x7c, 0x8d,   0xe2, 0xb3, 0x2e, 0x9c, 0xdf, 0x6e, 0x82, 0x88, 
+  0x89, 0xfd, 0x62, 0x07, 0x9f, 0xee, 0x85, 0x20,   0xe5, 0xdd, 0x69, 0x59, 0xc7, 0xc7, 0xa8, 0x87, 
+  0xc9, 0x74, 0x52, 0x4d, 0xe4, 0x30, 0x2e, 0x2d,   0x72, 0x64, 0xf8, 0xd2, 0x6d, 0x16, 0x70, 0x50, 
+  0x6a, 0x01, 0xed, 0x18, 0xf0, 0xf5, 0xf7, 0x66,   0xeb, 0xf3, 0xf4, 0xba, 0xc6, 0x8f, 0xbe, 0xff, 
+  0x0e, 0x00, 0xff, 0x0e, 0x83, 0x86, 0x0f, 0x06,   0x07, 0x49, 0x2e, 0x40, 0xa2, 0x1b, 0x61, 0xfa, 
+  0xca, 0xff, 0x0f, 0x18, 0xff, 0x0f, 0x9b, 0xb6,   0x10, 0x1e, 0x07, 0x29, 0x82, 0x21, 0x52, 0xc4, 
+  0xd5, 0xfb, 0x2b, 0x8c, 0x10, 0x60, 0x07, 0xee,   0x55, 0x9f, 0x5e, 0x48, 0x76, 0xc6, 0x9d, 0x84, 
+  0x10, 0x78, 0x0f, 0xbe, 0x48, 0xd9, 0x0a, 0x16,   0xa7, 0x0e, 0x33, 0x64, 0xb9, 0x79, 0x82, 0x04, 
+  0xc6, 0x0c, 0x29, 0xb4, 0x10, 0x90, 0x07, 0x74,   0x14, 0x43, 0x4d, 0x25, 0xe8, 0xd7, 0x8a, 0xb4, 
+  0x10, 0xd0, 0x07, 0x42, 0x96, 0x5e, 0x3b, 0x0e,   0xd0, 0xde, 0x83, 0x94, 0x11, 0x10, 0x17, 0xb6, 
+  0x46, 0x96, 0xb5, 0x24, 0x79, 0xda, 0x70, 0x3a,   0x6f, 0x2b, 0x8a, 0x05, 0xbb, 0xff, 0xf8, 0x7b, 
+  0x7b, 0xbc, 0x19, 0x84, 0xa2, 0x8f, 0x16, 0x84,   0x11, 0x40, 0x07, 0xd8, 0x51, 0x82, 0x5b, 0xc7, 
+  0x13, 0x12, 0x6e, 0x84, 0x11, 0x50, 0x0f, 0xb9,   0x7d, 0x89, 0x41, 0xe9, 0xcc, 0x78, 0x97, 0x2c, 
+  0xad, 0xce, 0xc7, 0x03, 0xe5, 0xa1, 0x93, 0xff,   0x11, 0x68, 0x81, 0x11, 0xeb, 0x07, 0x55, 0xb8, 
+  0x40, 0x1d, 0xc6, 0x53, 0xc3, 0x77, 0xff, 0x12,   0x30, 0xd9, 0x12, 0xb3, 0x27, 0x09, 0x41, 0x48, 
+  0x0a, 0x4e, 0x78, 0x93, 0xdc, 0x11, 0x93, 0x15,   0xd8, 0x28, 0xa9, 0x90, 0xf9, 0x13, 0x19, 0x1c, 
+  0xe9, 0x9b, 0xf7, 0xd5, 0x3a, 0x64, 0x9b, 0x15,   0xb2, 0x24, 0xe6, 0xc4, 0xc1, 0x5c, 0x15, 0x05, 
+  0xe3, 0x99, 0x20, 0x95, 0x1a, 0xe4, 0x13, 0x10,   0x07, 0x96, 0xaa, 0x17, 0x98, 0xcc, 0xeb, 0xb2, 
+  0xd6, 0x8c, 0x13, 0x80, 0x0f, 0x3c, 0xf1, 0x9f,   0x0c, 0xbb, 0x01, 0x2f, 0xb0, 0xec, 0xb7, 0x5a, 
+  0x5d, 0x81, 0x91, 0x38, 0x37, 0xbc, 0x13, 0xa0,   0x27, 0xfa, 0x7b, 0x30, 0x36, 0xa0, 0x71, 0x7e, 
+  0x13, 0x13, 0x9b, 0x58, 0xfc, 0xaa, 0x7d, 0x33,   0x27, 0x3c, 0x73, 0xa6, 0x93, 0x08, 0xaa, 0xea, 
+  0xe4, 0x80, 0xbb, 0x5a, 0x3d, 0x3a, 0x7c, 0x0f,   0x9c, 0x30, 0x2f, 0xd4, 0x02, 0xcb, 0x40, 0xec, 
+  0x91, 
+};
+
+// Container header for CCS811::flash_image(): 'C811', format 1, flags 0, version 2001, size 5112, CRC-16 96cc
+const uint8_t packed_header[] PROGMEM = {
+  0x43, 0x38, 0x31, 0x31, 0x01, 0x00, 0x20, 0x01, 0x13, 0xf8, 0x96, 0xcc, 
+};
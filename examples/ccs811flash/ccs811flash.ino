@@ -1,6 +1,7 @@
 /*
   ccs811flash.ino - Sketch to flash a CCS811 with 2.0.0 firmware.
   Created by Maarten Pennings 2018 Dec 10, updated 2020-03-07 change on ams website
+  2026 oct 17  Uses flash_image (image checked before erase, no reflash of the installed version)
 */
 
 
@@ -43,17 +44,17 @@ void setup() {
   Serial.print("setup: application version: "); Serial.println(ccs811.application_version(),HEX);
 
   // Check if flashing should be executed
-  if( ccs811.application_version()==0x2000 ) { Serial.println("init: already has 2.0.0"); return; } // Do not reflash
   Serial.println("setup: comment-out this code line if you want to flash"); return; // Extra precaution
 
-  // Flash
+  // Flash (flash_image checks the image before erasing, and does not reflash the version the CCS811 already has)
   Serial.print("setup: starting flash of '");
   Serial.print(image_name);
   Serial.println("' in 5 seconds");
   delay(5000);
   Serial.println("");
-  ok= ccs811.flash(image_data, sizeof(image_data));
-  if( !ok ) Serial.println("setup: CCS811 flash FAILED");
+  int res= ccs811.flash_image(image_header, image_data);
+  if( res==CCS811_IMAGE_SKIPPED ) Serial.println("setup: already has this version");
+  else if( res!=CCS811_IMAGE_FLASHED ) Serial.println("setup: CCS811 flash FAILED");
   Serial.println("");
 }
 
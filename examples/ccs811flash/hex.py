@@ -1,4 +1,7 @@
 # hex.py - converts any file to a c-style array
+# 2026 10 17                    v6  Option --embed: emits a small header that embeds the file with #embed or .incbin (no hex literals)
+# 2026 10 17                    v5  Option --pack: emits the image packed against a reference image (for CCS811Unpack)
+# 2026 10 17                    v4  Optional version argument: also emits the image container header (for flash_image)
 # 2020 05 17  Maarten Pennings  v3  Uses f-string, added extra NL
 # 2019 01 15  Maarten Pennings  v2  Added const/PROGMEM to array
 # 2018 12 05  Maarten Pennings  v1  Created
@@ -8,38 +11,141 @@ import os.path
 
 # This script needs Python 3.6
 
+# Is a reference for packing passed, or must the file be embedded?
+args= sys.argv[1:]
+reference= None
+embed= False
+if len(args)>=2 and args[0]=="--pack":
+    reference= args[1]
+    args= args[2:]
+elif len(args)>=1 and args[0]=="--embed":
+    embed= True
+    args= args[1:]
+
 # Is a filename passed?
-if len(sys.argv)!=2:
+if len(args)!=1 and len(args)!=2:
     print( "SYNTAX:" )
-    print( "  python hex.py <file>" )
+    print( "  python hex.py [--pack <reference> | --embed] <file> [<version>]" )
+    print( "  with <version> (e.g. 2.0.1) also emits image_header, the container header for CCS811::flash_image()" )
+    print( "  with --pack emits packed_xxx: <file> packed against <reference> (e.g. another version), see ccs811unpack.h" )
+    print( "  with --embed emits image_data as #embed (C23) or .incbin of <file>, instead of hex literals" )
     sys.exit(1)
 
-# Does file exists?
-name= sys.argv[1] # 'CCS811_FW_App_v2-0-0.bin'
-if not os.path.isfile(name):
-    print( f"File '{name}' does not exist" )
-    sys.exit(2)
+# Is a version passed?
+version= None
+if len(args)==2:
+    try:
+        major,minor,trivial= [ int(x) for x in args[1].split('.') ]
+        version= (major<<12) + (minor<<8) + trivial
+    except ValueError:
+        print( f"Version '{args[1]}' is not of the form major.minor.trivial" )
+        sys.exit(3)
 
-# Process file
-n= 0;
-f= open(name, 'rb')
-try:
-    print( f"// Hex dump of '{name}' created at {datetime.datetime.now()}" )
-    print( "" )
-    print( "#include <stdint.h>" )
-    print( "" )
-    print( f"const char * image_name=\"{name}\";" )
-    print( "const uint8_t image_data[] PROGMEM = {" )
-    byte= f.read(1)
-    while byte:
+# CRC-16/CCITT (polynomial 0x1021, start with 0xFFFF), as in ccs811.cpp
+def crc16(data):
+    crc= 0xFFFF
+    for byte in data:
+        crc^= byte<<8
+        for b in range(8):
+            crc= ((crc<<1)^0x1021 if crc&0x8000 else crc<<1) & 0xFFFF
+    return crc
+
+# Packs `data` against `ref` in the format of ccs811unpack.h (greedy, longest copy from ref)
+MINCOPY= 4
+def pack(data, ref):
+    index= {}
+    for i in range(len(ref)-MINCOPY+1): index.setdefault(ref[i:i+MINCOPY],[]).append(i)
+    out= bytearray()
+    literals= bytearray()
+    def flush(literals):
+        for i in range(0,len(literals),128):
+            out.append(len(literals[i:i+128])-1)
+            out.extend(literals[i:i+128])
+    i= 0
+    while i<len(data):
+        best,at= 0,0
+        for j in index.get(data[i:i+MINCOPY],[]):
+            n= 0
+            while i+n<len(data) and j+n<len(ref) and data[i+n]==ref[j+n] and n<0x7F+MINCOPY: n+= 1
+            if n>best: best,at= n,j
+        if best>=MINCOPY:
+            flush(literals)
+            literals= bytearray()
+            out.extend( [0x80|(best-MINCOPY), at>>8, at&0xFF] )
+            i+= best
+        else:
+            literals.append(data[i])
+            i+= 1
+    flush(literals)
+    return bytes(out)
+
+# Dumps `data` as the body of a C array
+def dump(data):
+    for n,byte in enumerate(data):
         if( n%16==0 ): print( "  ", end="" )
-        print( f"0x{byte[0]:02x}, ", end="" )
+        print( f"0x{byte:02x}, ", end="" )
         if( n%16==7 ): print( "  ", end="" )
         if( n%16==15 ): print()
-        byte= f.read(1)
-        n= n+1
-    if( n%16!=0 ): print()
-    print( "};" )
-finally:
-    f.close()
+    if( len(data)%16!=0 ): print()
+
+# Do files exist?
+name= args[0] # 'CCS811_FW_App_v2-0-0.bin'
+for file in [name] if reference is None else [name,reference]:
+    if not os.path.isfile(file):
+        print( f"File '{file}' does not exist" )
+        sys.exit(2)
 
+# Process file
+with open(name, 'rb') as f:
+    data= f.read()
+n= len(data)
+prefix= "image"
+print( f"// {'Embed' if embed else 'Hex dump'} of '{name}' created at {datetime.datetime.now()}" )
+print( "" )
+print( "#include <stdint.h>" )
+print( "" )
+print( f"const char * image_name=\"{name}\";" if reference is None else f"const char * packed_name=\"{name}\";" )
+if embed:
+    # The compiler resolves #embed relative to this header (as #include), the assembler resolves .incbin 
+    # relative to its working directory or a -Wa,-I<dir>; an absolute <file> works for both
+    print( f"// Embeds the {n} bytes of '{name}': with #embed (C23, e.g. gcc 15, clang 19) or else with the assembler's .incbin" )
+    print( "#if defined(__has_embed)" )
+    print( "const uint8_t image_data[] PROGMEM = {" )
+    print( f"#embed \"{name}\"" )
+    print( "};" )
+    print( "#else" )
+    print( "__asm__(" )
+    print( "#if defined(__AVR__)" )
+    print( "  \".pushsection .progmem.data,\\\"a\\\"\\n\"" )
+    print( "#else" )
+    print( "  \".pushsection .rodata\\n\"" )
+    print( "#endif" )
+    print( "  \".global image_data\\n\"" )
+    print( "  \"image_data:\\n\"" )
+    print( f"  \".incbin \\\"{name}\\\"\\n\"" )
+    print( "  \".popsection\\n\"" )
+    print( ");" )
+    print( f"extern const uint8_t image_data[{n}];" )
+    print( "#endif" )
+elif reference is None:
+    print( "const uint8_t image_data[] PROGMEM = {" )
+    dump(data)
+    print( "};" )
+else:
+    with open(reference, 'rb') as f:
+        packed= pack(data, f.read())
+    prefix= "packed"
+    print( f"const int packed_imagesize={n};" )
+    print( f"// '{name}' packed against '{reference}': {len(packed)} of {n} bytes ({100*len(packed)/n:.1f}%), see ccs811unpack.h" )
+    print( "const uint8_t packed_data[] PROGMEM = {" )
+    dump(packed)
+    print( "};" )
+    print( f"'{name}' packed against '{reference}': {len(packed)} of {n} bytes ({100*len(packed)/n:.1f}%)", file=sys.stderr )
+if version is not None:
+    crc= crc16(data)
+    header= [ord('C'),ord('8'),ord('1'),ord('1'), 1, 0, version>>8, version&0xFF, n>>8, n&0xFF, crc>>8, crc&0xFF]
+    print( "" )
+    print( f"// Container header for CCS811::flash_image(): 'C811', format 1, flags 0, version {version:04x}, size {n}, CRC-16 {crc:04x}" )
+    print( f"const uint8_t {prefix}_header[] PROGMEM = {{" )
+    print( "  " + "".join( f"0x{b:02x}, " for b in header ) )
+    print( "};" )
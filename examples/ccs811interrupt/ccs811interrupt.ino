@@ -0,0 +1,61 @@
+/*
+  ccs811interrupt.ino - Demo sketch reading the CCS811 only when it signals (via nINT) that a new sample is ready.
+  Created 2026 oct 17
+*/
+
+
+#include <Wire.h>    // I2C library
+#include "ccs811.h"  // CCS811 library
+
+
+// Wiring for ESP8266 NodeMCU boards: VDD to 3V3, GND to GND, SDA to D2, SCL to D1, nWAKE to D3 (or GND), nINT to D5
+CCS811 ccs811(D3, CCS811_SLAVEADDR_0, D5); // nWAKE on D3, nINT on D5
+
+// Wiring for Nano: VDD to 3v3, GND to GND, SDA to A4, SCL to A5, nWAKE to 13, nINT to 2 (an interrupt capable pin)
+//CCS811 ccs811(13, CCS811_SLAVEADDR_0, 2); 
+
+
+void setup() {
+  // Enable serial
+  Serial.begin(115200);
+  Serial.println("");
+  Serial.println("setup: Starting CCS811 interrupt demo");
+  Serial.print("setup: ccs811 lib  version: "); Serial.println(CCS811_VERSION);
+
+  // Enable I2C
+  Wire.begin(); 
+  
+  // Enable CCS811 (this also attaches an interrupt to nINT)
+  ccs811.set_i2cdelay(50); // Needed for ESP8266 because it doesn't handle I2C clock stretch correctly
+  bool ok= ccs811.begin();
+  if( !ok ) Serial.println("setup: CCS811 begin FAILED");
+
+  // Optionally, only interrupt when eCO2 changes band (below 1000ppm, 1000-2000ppm, above 2000ppm) 
+  //ccs811.set_thresholds(1000,2000,50);
+
+  // Start measuring (this also enables the data-ready interrupt, because nINT is passed to the constructor)
+  ok= ccs811.start(CCS811_MODE_1SEC);
+  if( !ok ) Serial.println("setup: CCS811 start FAILED");
+}
+
+
+void loop() {
+  // Only read when the CCS811 has a new sample; no (wasted) I2C transactions otherwise
+  if( ccs811.data_ready() ) {
+    uint16_t eco2, etvoc, errstat, raw;
+    ccs811.read(&eco2,&etvoc,&errstat,&raw); 
+    if( errstat==CCS811_ERRSTAT_OK ) { 
+      Serial.print("CCS811: ");
+      Serial.print("eco2=");  Serial.print(eco2);     Serial.print(" ppm  ");
+      Serial.print("etvoc="); Serial.print(etvoc);    Serial.print(" ppb  ");
+      Serial.println();
+    } else if( errstat & CCS811_ERRSTAT_I2CFAIL ) { 
+      Serial.println("CCS811: I2C error");
+    } else {
+      Serial.print("CCS811: errstat="); Serial.print(errstat,HEX); 
+      Serial.print("="); Serial.println( ccs811.errstat_str(errstat) ); 
+    }
+  }
+
+  // Other tasks go here
+}
@@ -0,0 +1,66 @@
+/*
+  ccs811multi.ino - Demo sketch reading two CCS811s (one on each slave address) via a CCS811Manager.
+  Created 2026 oct 17
+*/
+
+
+#include <Wire.h>          // I2C library
+#include "ccs811.h"        // CCS811 library
+#include "ccs811manager.h" // CCS811 library: multi-sensor scheduling
+
+
+// Wiring for ESP8266 NodeMCU boards: VDD to 3V3, GND to GND, SDA to D2, SCL to D1, nWAKE to D3 and D4 (or GND)
+// The ADDR pin of the first CCS811 is tied to GND (0x5A), of the second to VDD (0x5B)
+CCS811 ccs811a(D3, CCS811_SLAVEADDR_0); // nWAKE on D3
+CCS811 ccs811b(D4, CCS811_SLAVEADDR_1); // nWAKE on D4
+CCS811Manager manager;
+
+
+void setup() {
+  // Enable serial
+  Serial.begin(115200);
+  Serial.println("");
+  Serial.println("setup: Starting CCS811 multi demo");
+  Serial.print("setup: ccs811 lib  version: "); Serial.println(CCS811_VERSION);
+
+  // Enable I2C
+  Wire.begin(); 
+  
+  // Enable the CCS811s
+  ccs811a.set_i2cdelay(50); // Needed for ESP8266 because it doesn't handle I2C clock stretch correctly
+  ccs811b.set_i2cdelay(50);
+  if( !ccs811a.begin() ) Serial.println("setup: CCS811 a begin FAILED");
+  if( !ccs811b.begin() ) Serial.println("setup: CCS811 b begin FAILED");
+
+  // Start measuring (each sensor may have its own mode)
+  if( !ccs811a.start(CCS811_MODE_1SEC) ) Serial.println("setup: CCS811 a start FAILED");
+  if( !ccs811b.start(CCS811_MODE_10SEC) ) Serial.println("setup: CCS811 b start FAILED");
+
+  // Hand them to the manager
+  manager.add(&ccs811a);
+  manager.add(&ccs811b);
+}
+
+
+void loop() {
+  // Only the sensors with a sample due are read; no (wasted) I2C transactions otherwise
+  uint16_t eco2, etvoc, errstat, raw;
+  int i;
+  while( (i=manager.poll(&eco2,&etvoc,&errstat,&raw)) >= 0 ) {
+    Serial.print("CCS811 "); Serial.print(i==0 ? 'a' : 'b'); Serial.print(": ");
+    if( errstat==CCS811_ERRSTAT_OK ) { 
+      Serial.print("eco2=");  Serial.print(eco2);     Serial.print(" ppm  ");
+      Serial.print("etvoc="); Serial.print(etvoc);    Serial.print(" ppb  ");
+      Serial.println();
+    } else if( errstat==CCS811_ERRSTAT_OK_NODATA ) {
+      Serial.println("waiting for (new) data");
+    } else if( errstat & CCS811_ERRSTAT_I2CFAIL ) { 
+      Serial.println("I2C error");
+    } else {
+      Serial.print("errstat="); Serial.print(errstat,HEX); 
+      Serial.print("="); Serial.println( manager.sensor(i)->errstat_str(errstat) ); 
+    }
+  }
+
+  // Other tasks go here
+}
@@ -0,0 +1,101 @@
+/*
+  Arduino.h - Minimal host (Linux) stand-in for the Arduino core, so that the CCS811 driver can run on a PC.
+  Time is virtual: delay() and delayMicroseconds() advance a simulated clock instead of sleeping.
+  2026 oct 17  v3  Added Stream
+  2026 oct 17  v2  Added interrupts
+  2026 oct 17  v1  Created
+*/
+#ifndef _HOST_ARDUINO_H_
+#define _HOST_ARDUINO_H_
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+typedef uint8_t byte;
+
+
+// Pin levels and modes
+#define LOW                0
+#define HIGH               1
+#define INPUT              0
+#define OUTPUT             1
+#define INPUT_PULLUP       2
+
+
+// Number bases for Serial.print
+#define DEC               10
+#define HEX               16
+
+
+// There is no separate program memory on the host
+#define PROGMEM
+#define F(s)               (s)
+#define memcpy_P(d,s,n)    memcpy((d),(s),(n))
+#define pgm_read_byte(p)   (*(const uint8_t*)(p))
+
+
+// Interrupt modes
+#define CHANGE             1
+#define FALLING            2
+#define RISING             3
+
+
+// GPIO
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int level);
+int  digitalRead(int pin);
+
+
+// Interrupts (an ISR runs synchronously when a simulated device drives its pin, see host_pin_drive)
+#define digitalPinToInterrupt(pin)  (pin)
+void attachInterrupt(int irq, void (*isr)(void), int mode);
+void detachInterrupt(int irq);
+void noInterrupts(void);
+void interrupts(void);
+
+
+// Time (virtual)
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+
+// Stream (input side only): a source of bytes, e.g. a file or a serial upload
+class Stream {
+  public:
+    virtual ~Stream() {}
+    virtual int available(void) = 0;                                          // Number of bytes that can be read.
+    virtual int read(void) = 0;                                               // Next byte, or -1 when there is none.
+    void setTimeout(unsigned long ms);                                        // Time readBytes() waits for a byte (default 1000ms).
+    size_t readBytes(uint8_t * buf, size_t len);                              // Reads up to `len` bytes into `buf`; returns the number read (less on timeout).
+  protected:
+    unsigned long _timeout= 1000;
+};
+
+
+// Serial (prints to stdout, unless silenced via host_serial_enable)
+class HostSerial {
+  public:
+    void begin(long baud);
+    void print(const char * s);
+    void print(char c);
+    void print(int v, int base=DEC);
+    void print(unsigned int v, int base=DEC);
+    void print(long v, int base=DEC);
+    void print(unsigned long v, int base=DEC);
+    void println(void);
+    void println(const char * s);
+    void println(char c);
+    void println(int v, int base=DEC);
+    void println(unsigned int v, int base=DEC);
+    void println(long v, int base=DEC);
+    void println(unsigned long v, int base=DEC);
+};
+extern HostSerial Serial;
+
+
+#endif
@@ -0,0 +1,91 @@
+/*
+  Wire.cpp - Host (Linux) stand-in for the Arduino Wire library, backed by a simulated I2C bus (see host.h).
+  2026 oct 17  v2  Transfers are accounted in HostStats
+  2026 oct 17  v1  Created
+*/
+
+
+#include "Arduino.h"
+#include "Wire.h"
+
+
+TwoWire Wire;
+
+
+TwoWire::TwoWire() {
+  _txaddr= -1;
+  _txlen= 0;
+  _txoverflow= false;
+  _rxlen= 0;
+  _rxpos= 0;
+}
+
+
+void TwoWire::begin(void) {
+}
+
+
+void TwoWire::setClock(long hz) {
+  host_i2c_set_clock(hz);
+}
+
+
+void TwoWire::beginTransmission(int addr) {
+  _txaddr= addr;
+  _txlen= 0;
+  _txoverflow= false;
+}
+
+
+int TwoWire::write(uint8_t data) {
+  if( _txlen>=HOST_WIRE_BUFSIZE ) { _txoverflow= true; return 0; }
+  _txbuf[_txlen++]= data;
+  return 1;
+}
+
+
+// 0=ok, 1=too long, 2=NACK on address, 3=NACK on data
+int TwoWire::endTransmission(bool stop) {
+  (void)stop; // The simulated slaves do not distinguish STOP from repeated START
+  if( _txoverflow ) return 1;
+  HostI2CDevice * dev= _bus.find(_txaddr);
+  if( dev==0 ) { host_stats_transfer(1,false); return 2; }
+  bool ack= dev->write(_txaddr,_txbuf,_txlen);
+  host_stats_transfer(ack?1+_txlen:1,ack);
+  if( !ack ) return 2;
+  return 0;
+}
+
+
+// Returns number of bytes received (0 on NACK)
+int TwoWire::requestFrom(int addr, int count, bool stop) {
+  (void)stop;
+  _rxlen= 0;
+  _rxpos= 0;
+  if( count>HOST_WIRE_BUFSIZE ) count= HOST_WIRE_BUFSIZE;
+  HostI2CDevice * dev= _bus.find(addr);
+  if( dev==0 ) { host_stats_transfer(1,false); return 0; }
+  bool ack= dev->read(addr,_rxbuf,count);
+  host_stats_transfer(ack?1+count:1,ack);
+  if( !ack ) return 0;
+  _rxlen= count;
+  return count;
+}
+
+
+int TwoWire::available(void) {
+  return _rxlen-_rxpos;
+}
+
+
+// Returns -1 when no more bytes are available
+int TwoWire::read(void) {
+  if( _rxpos>=_rxlen ) return -1;
+  return _rxbuf[_rxpos++];
+}
+
+
+// The simulated bus behind this Wire.
+HostI2CBus * TwoWire::bus(void) {
+  return &_bus;
+}
@@ -0,0 +1,42 @@
+/*
+  Wire.h - Host (Linux) stand-in for the Arduino Wire library, backed by a simulated I2C bus (see host.h).
+  2026 oct 17  v1  Created
+*/
+#ifndef _HOST_WIRE_H_
+#define _HOST_WIRE_H_
+
+
+#include <stdint.h>
+#include "host.h"
+
+
+#define HOST_WIRE_BUFSIZE  32 // Same as the AVR Wire buffer
+
+
+class TwoWire {
+  public: // Arduino interface
+    TwoWire();
+    void    begin(void);
+    void    setClock(long hz);
+    void    beginTransmission(int addr);
+    int     write(uint8_t data);
+    int     endTransmission(bool stop=true);                                  // 0=ok, 1=too long, 2=NACK on address, 3=NACK on data
+    int     requestFrom(int addr, int count, bool stop=true);                 // Returns number of bytes received (0 on NACK)
+    int     available(void);
+    int     read(void);                                                       // Returns -1 when no more bytes are available
+  public: // Host interface
+    HostI2CBus * bus(void);                                                   // The simulated bus behind this Wire.
+  private:
+    HostI2CBus _bus;
+    int     _txaddr;
+    uint8_t _txbuf[HOST_WIRE_BUFSIZE];
+    int     _txlen;
+    bool    _txoverflow;
+    uint8_t _rxbuf[HOST_WIRE_BUFSIZE];
+    int     _rxlen;
+    int     _rxpos;
+};
+extern TwoWire Wire;
+
+
+#endif
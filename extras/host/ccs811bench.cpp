@@ -0,0 +1,432 @@
+/*
+  ccs811bench.cpp - Bus cost benchmark of the CCS811 driver: per API call the START conditions, bytes on the wire,
+  nWAKE low time and time spent waiting, against the simulated CCS811 (what the calls return is tested in ccs811test.cpp).
+  Prints CSV on stdout. With --check <budgetfile> it exits with 1 when a call exceeds its budget.
+  2026 oct 17  v25 begin_warm cases moved next to the other begin cases
+  2026 oct 17  v24 Baseline cases moved next to the other loops
+  2026 oct 17  v23 Functional checks moved to ccs811test.cpp; every case fails on I2C problems
+  2026 oct 17  v22 Added ENV_DATA fan-out (in order versus CCS811Manager)
+  2026 oct 17  v21 Added ENV_DATA dead-band loops
+  2026 oct 17  v20 Added set_envdata_mCelsius_mpercRH (checked against the float formula)
+  2026 oct 17  v19 Added the baseline manager
+  2026 oct 17  v18 Added begin_warm
+  2026 oct 17  v17 Added flash_image/packed
+  2026 oct 17  v16 Added flash_image (container)
+  2026 oct 17  v15 Added flash from a Stream
+  2026 oct 17  v14 Added parallel flash
+  2026 oct 17  v13 Added adaptive timing
+  2026 oct 17  v12 Added non-blocking flash
+  2026 oct 17  v11 Added mux loops (TCA9548A)
+  2026 oct 17  v10 Added multi-sensor loops (naive and CCS811Manager)
+  2026 oct 17  v9  Added Linux transport (via the /dev/i2c-N stand-in)
+  2026 oct 17  v8  Added field-selective reads
+  2026 oct 17  v7  Added read of a steady stream (mailbox still selected)
+  2026 oct 17  v6  Added wake session
+  2026 oct 17  v5  Added raw reads
+  2026 oct 17  v4  Added threshold loop
+  2026 oct 17  v3  Added nINT loops
+  2026 oct 17  v2  Added non-blocking read
+  2026 oct 17  v1  Created
+*/
+
+
+#include <stdio.h>
+#include <string.h>
+#include "Arduino.h"
+#include "Wire.h"
+#include "host.h"
+#include "ccs811sim.h"
+#include "ccs811.h"
+#include "linuxbussim.h"
+#include "ccs811manager.h"
+#include "ccs811mux.h"
+#include "muxsim.h"
+#include "ccs811unpack.h"
+#include "ccs811baseline.h"
+#include "ccs811filestore.h"
+
+
+// The firmware image as byte array in C
+#include "../../examples/ccs811flash/CCS811_FW_App_v2-0-0.h"
+#include "../../examples/ccs811flash/CCS811_FW_App_v2-0-1.pack.h"
+
+
+#define NWAKE 3
+#define NINT  4
+#define BENCH_MULTI 8
+
+
+// A benchmark case ===================================================================================================
+
+
+struct Bench {
+  const char * name;                                                          // Name as printed (and used in budget file)
+  uint16_t     appversion;                                                    // Firmware in the simulated CCS811
+  int          prepare;                                                       // What to do before the measured call (PREP_XXX)
+  bool       (*call)(CCS811 & ccs811);                                        // The measured call, returns success
+  bool         nint;                                                          // nINT connected
+  int          transport;                                                     // I2C transport of the driver (BUS_XXX)
+};
+
+#define BUS_WIRE       0 // CCS811WireBus on Wire
+#define BUS_LINUX      1 // CCS811LinuxBus, with the userspace stand-in for /dev/i2c-N
+
+
+#define PREP_NONE      0 // Fresh device, begin() not yet called
+#define PREP_STARTED   1 // begin(), start(1SEC), and a sample is ready
+#define PREP_NODATA    2 // begin(), start(1SEC), no sample yet
+#define PREP_HWERROR   3 // as PREP_STARTED, but with a heater fault in ERROR_ID
+#define PREP_RAW       4 // begin(), start(250MS), and a sample is ready
+#define PREP_READ      5 // as PREP_STARTED, but the previous sample was read with read() already
+#define PREP_MULTI     6 // as PREP_NODATA, plus BENCH_MULTI-1 more sensors (nWAKE to GND) on the next slave addresses
+#define PREP_MUX       7 // BENCH_MULTI sensors (nWAKE to GND) behind a TCA9548A (4 channels, 2 slave addresses), started, samples ready
+#define PREP_MUXNOCACHE 8 // as PREP_MUX, but CCS811Mux has its channel cache disabled
+
+
+// Result of one benchmark case
+struct Cost {
+  uint32_t starts;
+  uint32_t bytes;
+  uint64_t wake_us;
+  uint64_t delay_us;
+  uint64_t bus_us;
+  uint64_t total_us;
+};
+
+
+static uint16_t bench_errstat;
+
+static bool call_begin(CCS811 & c)          { return c.begin(); }
+static bool call_begin_adaptive(CCS811 & c) { c.set_adaptive_timing(true); return c.begin(); }
+// Warm start of a running CCS811 (as after a host reboot), and of a fresh one (falls back to begin)
+static bool call_begin_warm(CCS811 & c)     { return c.begin_warm(); }
+static bool call_start(CCS811 & c)          { return c.start(CCS811_MODE_1SEC); }
+static bool call_read(CCS811 & c)           { uint16_t eco2, etvoc, raw; c.read(&eco2,&etvoc,&bench_errstat,&raw); return (bench_errstat&CCS811_ERRSTAT_I2CFAIL)==0; }
+static bool call_read_eco2(CCS811 & c)      { uint16_t eco2; c.read(&eco2,0,0,0); return eco2!=0; } // 0 on I2C problems
+static bool call_read_noraw(CCS811 & c)     { uint16_t eco2, etvoc; c.read(&eco2,&etvoc,&bench_errstat,0); return (bench_errstat&CCS811_ERRSTAT_I2CFAIL)==0; }
+static bool call_read_i2cdelay(CCS811 & c) { c.set_i2cdelay(50); return call_read(c); }
+static bool call_read_async(CCS811 & c)     { uint16_t eco2, etvoc, raw; c.read_begin(); while( !c.read_poll(&eco2,&etvoc,&bench_errstat,&raw) ) host_advance_us(10); return (bench_errstat&CCS811_ERRSTAT_I2CFAIL)==0; }
+// Reads for 10 seconds in 1 second mode: blind every 500ms, or only when nINT signals a sample (checked every 10ms)
+static bool call_loop_blind(CCS811 & c)     { for( int t=0; t<10000; t+=500 ) { if( !call_read(c) ) return false; delay(500); } return true; }
+static bool call_loop_nint(CCS811 & c)      { for( int t=0; t<10000; t+=10 ) { if( c.data_ready() && !call_read(c) ) return false; delay(10); } return true; }
+// Reads for 60 seconds in 1 second mode, with threshold interrupts; eCO2 goes from low to medium once
+static CCS811Sim * bench_sim;
+static bool call_loop_thresh(CCS811 & c)    { 
+  c.set_thresholds(1500,2500,50); c.start(CCS811_MODE_1SEC);
+  for( int t=0; t<60000; t+=10 ) { if( t==30000 ) bench_sim->set_air(1600,100); if( c.data_ready() && !call_read(c) ) return false; delay(10); } 
+  return true; 
+}
+// Baseline manager on a 60 byte file store (12 slots), polled every second. First power-up: nothing stored, saved after 24h20m.
+#define BENCH_STORE "ccs811bench.store"
+static bool call_baseline_save(CCS811 & c)  {
+  remove(BENCH_STORE);
+  CCS811FileStore store(BENCH_STORE,60);
+  CCS811Baseline baseline(&c,&store);
+  baseline.begin();
+  bool ok= true;
+  for( int s=0; s<25*60*60; s++ ) { if( baseline.poll()==CCS811BASELINE_FAILED ) ok= false; delay(1000); }
+  remove(BENCH_STORE);
+  return ok;
+}
+// Next power-up: the stored baseline (0x1234, in slot 0) is restored after the 20 minute warm-up
+static bool call_baseline_restore(CCS811 & c)  {
+  remove(BENCH_STORE);
+  CCS811FileStore store(BENCH_STORE,60);
+  const uint8_t slot[CCS811BASELINE_SLOT_SIZE]= { 0x00, 0x01, 0x12, 0x34, 0x27 }; // seq 1, baseline 0x1234, CRC-8
+  store.write(0,slot,sizeof slot);
+  CCS811Baseline baseline(&c,&store);
+  baseline.begin();
+  bool ok= true;
+  for( int s=0; s<21*60; s++ ) { if( baseline.poll()==CCS811BASELINE_FAILED ) ok= false; delay(1000); }
+  remove(BENCH_STORE);
+  return ok;
+}
+// Reads BENCH_MULTI sensors in 1 second mode for 60 seconds: naively all of them every loop (of 100ms), or via a manager (loop of 10ms)
+static CCS811 * bench_multi[BENCH_MULTI];
+static bool call_multi_naive(CCS811 & c)    { 
+  (void)c; 
+  for( int t=0; t<60000; t+=100 ) { 
+    for( int i=0; i<BENCH_MULTI; i++ ) { uint16_t eco2, etvoc, errstat, raw; bench_multi[i]->read(&eco2,&etvoc,&errstat,&raw); if( errstat&CCS811_ERRSTAT_I2CFAIL ) return false; } 
+    delay(100); 
+  } 
+  return true; 
+}
+static bool call_multi_manager(CCS811 & c)  { 
+  (void)c; 
+  CCS811Manager mgr;
+  for( int i=0; i<BENCH_MULTI; i++ ) mgr.add(bench_multi[i]);
+  for( int t=0; t<60000; t+=10 ) { uint16_t eco2, etvoc, errstat, raw; while( mgr.poll(&eco2,&etvoc,&errstat,&raw)>=0 ) if( errstat & CCS811_ERRSTAT_I2CFAIL ) return false; delay(10); } 
+  return true;
+}
+// Reads the BENCH_MULTI sensors behind the mux every second for 60 seconds, in order (so each read switches channel)
+static bool call_mux_inorder(CCS811 & c)    {
+  (void)c;
+  for( int t=0; t<60000; t+=1000 ) { 
+    for( int i=0; i<BENCH_MULTI; i++ ) { uint16_t eco2, etvoc, errstat, raw; bench_multi[i]->read(&eco2,&etvoc,&errstat,&raw); if( errstat&CCS811_ERRSTAT_I2CFAIL ) return false; } 
+    delay(1000); 
+  }
+  return true;
+}
+// One T/H sample to the BENCH_MULTI sensors behind the mux: converted and written per sensor in order (so each write 
+// switches channel), or converted once and written grouped by channel by the manager
+static bool call_envdata_inorder(CCS811 & c) {
+  (void)c;
+  for( int i=0; i<BENCH_MULTI; i++ ) if( !bench_multi[i]->set_envdata_Celsius_percRH(23.5,48.5) ) return false;
+  return true;
+}
+static bool call_envdata_manager(CCS811 & c) {
+  (void)c;
+  CCS811Manager mgr;
+  for( int i=0; i<BENCH_MULTI; i++ ) mgr.add(bench_multi[i]);
+  return mgr.set_envdata_mCelsius_mpercRH(23500,48500)==BENCH_MULTI;
+}
+static bool call_read_raw(CCS811 & c)       { uint16_t raw; return c.read_raw(&raw); }
+static bool call_read_raw_ring(CCS811 & c)  { 
+  uint16_t buf[8]; CCS811RawRing ring= { buf, 8, 0, 0 }; 
+  for( int i=0; i<8; i++ ) { if( !c.read_raw(&ring) ) return false; delay(250); } 
+  return true; 
+}
+// The three version reads of the examples' setup(), each with their own wake-up, or in one wake session
+static bool call_versions(CCS811 & c)       { return c.hardware_version()>=0 && c.bootloader_version()>=0 && c.application_version()>=0; }
+static bool call_versions_session(CCS811 & c) { CCS811WakeSession session(c); return call_versions(c); }
+static bool call_set_envdata(CCS811 & c)    { return c.set_envdata(0x6400,0x6100); }
+static bool call_set_envdata210(CCS811 & c) { return c.set_envdata210(19000,25000); }
+static bool call_set_envdata_f(CCS811 & c)  { return c.set_envdata_Celsius_percRH(23.5,48.5); }
+static bool call_set_envdata_m(CCS811 & c)  { return c.set_envdata_mCelsius_mpercRH(23500,48500); }
+// A T/H sensor read every second (jitter of 0.1C and 0.4%RH, a 1C step at 40s) is passed to ENV_DATA for 60 seconds; 
+// with a dead-band of 0.5C, 1%RH and 30s, only the first, the aged (30s) and the step (40s) are written
+static bool call_envdata_loop(CCS811 & c)   {
+  for( int s=0; s<60; s++ ) { 
+    if( !c.set_envdata_mCelsius_mpercRH(23000+(s%5)*25+(s>=40?1000:0),48000+(s%3)*200) ) return false; 
+    delay(1000); 
+  }
+  return true;
+}
+static bool call_envdata_deadband(CCS811 & c) { c.set_envdata_deadband(256,512,30000); return call_envdata_loop(c); }
+static bool call_get_baseline(CCS811 & c)   { uint16_t b; return c.get_baseline(&b); }
+static bool call_set_baseline(CCS811 & c)   { return c.set_baseline(0x843D); }
+static bool call_hardware_version(CCS811 & c)    { return c.hardware_version()>=0; }
+static bool call_bootloader_version(CCS811 & c)  { return c.bootloader_version()>=0; }
+static bool call_application_version(CCS811 & c) { return c.application_version()>=0; }
+static bool call_get_errorid(CCS811 & c)    { return c.get_errorid()>=0; }
+static bool call_flash(CCS811 & c)          { return c.flash(image_data, sizeof(image_data)); }
+static bool call_flash_adaptive(CCS811 & c) { c.set_adaptive_timing(true); return c.flash(image_data, sizeof(image_data)); }
+// Flash from a Stream (as from an SD file): the image is not passed as a whole
+class BenchStream : public Stream {
+  public:
+    BenchStream(const uint8_t * data, int size) : _data(data), _size(size), _pos(0) {}
+    virtual int available(void) { return _size-_pos; }
+    virtual int read(void) { return _pos<_size ? _data[_pos++] : -1; }
+  private:
+    const uint8_t * _data;
+    int _size;
+    int _pos;
+};
+static bool call_flash_stream(CCS811 & c)   { BenchStream stream(image_data, sizeof(image_data)); return c.flash(stream, sizeof(image_data)); }
+// Flash of an image container: validated, skipped when installed, rejected when corrupt (before any I2C)
+static bool call_flash_image(CCS811 & c)    { return c.flash_image(image_header, image_data)==CCS811_IMAGE_FLASHED; }
+static bool call_flash_image_skip(CCS811 & c) { return c.flash_image(image_header, image_data)==CCS811_IMAGE_SKIPPED; }
+static int  bench_corrupt_reader(void * context, uint8_t * buf, int pos, int len) {
+  (void)context;
+  for( int i=0; i<len; i++ ) buf[i]= pos+i<CCS811_IMAGE_HEADER_SIZE ? image_header[pos+i] : image_data[pos+i-CCS811_IMAGE_HEADER_SIZE];
+  if( pos<=1000 && 1000<pos+len ) buf[1000-pos]^= 0x01; // One bit flipped in the image
+  return len;
+}
+static bool call_flash_image_corrupt(CCS811 & c) { return c.flash_image(bench_corrupt_reader, 0)==CCS811_IMAGE_INVALID; }
+// Flash of the 2.0.1 container, packed against 2.0.0 (the CRC check of flash_image also checks the unpacking)
+static bool call_flash_image_packed(CCS811 & c) {
+  CCS811Unpack unpack(packed_data, sizeof(packed_data), image_data, sizeof(image_data));
+  unpack.set_header(packed_header);
+  return c.flash_image(CCS811Unpack::reader, &unpack)==CCS811_IMAGE_FLASHED;
+}
+// Flashes the BENCH_MULTI sensors one after the other, or in parallel via a manager
+static bool call_flash_serial(CCS811 & c)   { (void)c; for( int i=0; i<BENCH_MULTI; i++ ) if( !bench_multi[i]->flash(image_data, sizeof(image_data)) ) return false; return true; }
+static bool call_flash_manager(CCS811 & c)  { 
+  (void)c; 
+  CCS811Manager mgr;
+  for( int i=0; i<BENCH_MULTI; i++ ) mgr.add(bench_multi[i]);
+  return mgr.flash(image_data, sizeof(image_data))==BENCH_MULTI;
+}
+// Non-blocking flash, polled every ms (as from a loop() with other tasks); fails when a poll ever takes more than 2ms
+static bool call_flash_poll(CCS811 & c)     { 
+  if( !c.flash_begin(image_data, sizeof(image_data)) ) return false;
+  int res;
+  do { uint64_t t= host_time_us(); res= c.flash_poll(); if( host_time_us()-t>2000 ) return false; delay(1); } while( res==CCS811_FLASH_BUSY );
+  return res==CCS811_FLASH_DONE;
+}
+
+
+static const Bench benches[]= {
+  { "begin/fw2000",              0x2000, PREP_NONE,    call_begin, false, BUS_WIRE },
+  { "begin/fw2000/adaptive",     0x2000, PREP_NONE,    call_begin_adaptive, false, BUS_WIRE },
+  { "begin/fw1100",              0x1100, PREP_NONE,    call_begin, false, BUS_WIRE },
+  { "begin_warm/running",        0x2000, PREP_STARTED, call_begin_warm, false, BUS_WIRE },
+  { "begin_warm/cold",           0x2000, PREP_NONE,    call_begin_warm, false, BUS_WIRE },
+  { "start",                     0x2000, PREP_STARTED, call_start, false, BUS_WIRE },
+  { "read/fw2000",               0x2000, PREP_STARTED, call_read, false, BUS_WIRE },
+  { "read/fw2000/steady",        0x2000, PREP_READ,    call_read, false, BUS_WIRE },
+  { "read/fw2000/eco2",          0x2000, PREP_STARTED, call_read_eco2, false, BUS_WIRE },
+  { "read/fw2000/noraw",         0x2000, PREP_STARTED, call_read_noraw, false, BUS_WIRE },
+  { "read/fw2000/nodata",        0x2000, PREP_NODATA,  call_read, false, BUS_WIRE },
+  { "read/fw2000/hwerror",       0x2000, PREP_HWERROR, call_read, false, BUS_WIRE },
+  { "read/fw1100",               0x1100, PREP_STARTED, call_read, false, BUS_WIRE },
+  { "read/fw1100/nodata",        0x1100, PREP_NODATA,  call_read, false, BUS_WIRE },
+  { "read/fw1100/hwerror",       0x1100, PREP_HWERROR, call_read, false, BUS_WIRE },
+  { "read_poll/fw2000",          0x2000, PREP_STARTED, call_read_async, false, BUS_WIRE },
+  { "read_poll/fw2000/hwerror",  0x2000, PREP_HWERROR, call_read_async, false, BUS_WIRE },
+  { "read_poll/fw1100",          0x1100, PREP_STARTED, call_read_async, false, BUS_WIRE },
+  { "loop10s/blind",             0x2000, PREP_STARTED, call_loop_blind, false, BUS_WIRE },
+  { "loop10s/nint",              0x2000, PREP_STARTED, call_loop_nint,  true, BUS_WIRE },
+  { "loop60s/thresh",            0x2000, PREP_NODATA,  call_loop_thresh, true, BUS_WIRE },
+  { "loop25h/baseline",          0x2000, PREP_STARTED, call_baseline_save, false, BUS_WIRE },
+  { "loop21m/baseline/restore",  0x2000, PREP_STARTED, call_baseline_restore, false, BUS_WIRE },
+  { "loop60s/multi8/naive",      0x2000, PREP_MULTI,   call_multi_naive, false, BUS_WIRE },
+  { "loop60s/multi8/manager",    0x2000, PREP_MULTI,   call_multi_manager, false, BUS_WIRE },
+  { "loop60s/mux8/nocache",      0x2000, PREP_MUXNOCACHE, call_multi_manager, false, BUS_WIRE },
+  { "loop60s/mux8/inorder",      0x2000, PREP_MUX,     call_mux_inorder, false, BUS_WIRE },
+  { "loop60s/mux8/manager",      0x2000, PREP_MUX,     call_multi_manager, false, BUS_WIRE },
+  { "envdata/mux8/inorder",      0x2000, PREP_MUX,     call_envdata_inorder, false, BUS_WIRE },
+  { "envdata/mux8/manager",      0x2000, PREP_MUX,     call_envdata_manager, false, BUS_WIRE },
+  { "read_raw",                  0x2000, PREP_RAW,     call_read_raw, false, BUS_WIRE },
+  { "read_raw/ring8",            0x2000, PREP_RAW,     call_read_raw_ring, false, BUS_WIRE },
+  { "set_envdata",               0x2000, PREP_STARTED, call_set_envdata, false, BUS_WIRE },
+  { "set_envdata210",            0x2000, PREP_STARTED, call_set_envdata210, false, BUS_WIRE },
+  { "set_envdata_Celsius_percRH",0x2000, PREP_STARTED, call_set_envdata_f, false, BUS_WIRE },
+  { "set_envdata_mCelsius_mpercRH",0x2000, PREP_STARTED, call_set_envdata_m, false, BUS_WIRE },
+  { "loop60s/envdata",           0x2000, PREP_STARTED, call_envdata_loop, false, BUS_WIRE },
+  { "loop60s/envdata/deadband",  0x2000, PREP_STARTED, call_envdata_deadband, false, BUS_WIRE },
+  { "get_baseline",              0x2000, PREP_STARTED, call_get_baseline, false, BUS_WIRE },
+  { "set_baseline",              0x2000, PREP_STARTED, call_set_baseline, false, BUS_WIRE },
+  { "hardware_version",          0x2000, PREP_STARTED, call_hardware_version, false, BUS_WIRE },
+  { "bootloader_version",        0x2000, PREP_STARTED, call_bootloader_version, false, BUS_WIRE },
+  { "application_version",       0x2000, PREP_STARTED, call_application_version, false, BUS_WIRE },
+  { "versions",                  0x2000, PREP_STARTED, call_versions, false, BUS_WIRE },
+  { "versions/session",          0x2000, PREP_STARTED, call_versions_session, false, BUS_WIRE },
+  { "get_errorid",               0x2000, PREP_STARTED, call_get_errorid, false, BUS_WIRE },
+  { "read/fw2000/linux",         0x2000, PREP_STARTED, call_read, false, BUS_LINUX },
+  { "read/fw2000/i2cdelay",       0x2000, PREP_STARTED, call_read_i2cdelay, false, BUS_WIRE },
+  { "read/fw2000/i2cdelay/linux", 0x2000, PREP_STARTED, call_read_i2cdelay, false, BUS_LINUX },
+  { "read/fw2000/steady/linux",  0x2000, PREP_READ,    call_read, false, BUS_LINUX },
+  { "read/fw1100/linux",         0x1100, PREP_STARTED, call_read, false, BUS_LINUX },
+  { "read_poll/fw2000/linux",    0x2000, PREP_STARTED, call_read_async, false, BUS_LINUX },
+  { "flash/fw1100",              0x1100, PREP_NONE,    call_flash, false, BUS_WIRE },
+  { "flash/fw1100/adaptive",     0x1100, PREP_NONE,    call_flash_adaptive, false, BUS_WIRE },
+  { "flash/fw1100/stream",       0x1100, PREP_NONE,    call_flash_stream, false, BUS_WIRE },
+  { "flash_image/fw1100",        0x1100, PREP_NONE,    call_flash_image, false, BUS_WIRE },
+  { "flash_image/fw2000",        0x2000, PREP_NONE,    call_flash_image_skip, false, BUS_WIRE },
+  { "flash_image/corrupt",       0x1100, PREP_NONE,    call_flash_image_corrupt, false, BUS_WIRE },
+  { "flash_image/packed",        0x1100, PREP_NONE,    call_flash_image_packed, false, BUS_WIRE },
+  { "flash/multi8/serial",       0x1100, PREP_MULTI,   call_flash_serial, false, BUS_WIRE },
+  { "flash/multi8/manager",      0x1100, PREP_MULTI,   call_flash_manager, false, BUS_WIRE },
+  { "flash_poll/fw1100",         0x1100, PREP_NONE,    call_flash_poll, false, BUS_WIRE },
+};
+#define BENCH_COUNT ( (int)(sizeof(benches)/sizeof(benches[0])) )
+
+
+// Runs benchmark `b` on a fresh simulated CCS811 and a fresh driver, returns false if the call failed.
+static bool bench_run(const Bench * b, Cost * cost) {
+  CCS811Sim sim(CCS811_SLAVEADDR_0, NWAKE, b->appversion);
+  Wire.bus()->attach(&sim);
+  CCS811LinuxBusSim linuxbus(Wire.bus());
+  CCS811 ccs811(NWAKE, CCS811_SLAVEADDR_0, b->nint ? NINT : -1, b->transport==BUS_LINUX ? &linuxbus : 0);
+  if( b->nint ) sim.set_nint(NINT);
+  bench_sim= &sim;
+  CCS811Sim * sims[BENCH_MULTI];
+  int multi= b->prepare==PREP_MULTI ? BENCH_MULTI : 1;
+  bench_multi[0]= &ccs811;
+  for( int i=1; i<multi; i++ ) {
+    sims[i]= new CCS811Sim(CCS811_SLAVEADDR_0+i, -1, b->appversion);
+    Wire.bus()->attach(sims[i]);
+    bench_multi[i]= new CCS811(-1, CCS811_SLAVEADDR_0+i);
+    bench_multi[i]->begin();
+    bench_multi[i]->start(CCS811_MODE_1SEC);
+  }
+  // Mux: BENCH_MULTI sensors replace the one of this case, sensor i is on channel i%4 (so consecutive sensors are on other channels)
+  bool mux= b->prepare==PREP_MUX || b->prepare==PREP_MUXNOCACHE;
+  TCA9548ASim muxsim(CCS811MUX_SLAVEADDR);
+  CCS811Mux ccs811mux(0, CCS811MUX_SLAVEADDR, b->prepare==PREP_MUX);
+  CCS811MuxBus * muxbuses[BENCH_MULTI];
+  if( mux ) {
+    Wire.bus()->detach(&sim);
+    Wire.bus()->attach(&muxsim);
+    for( int i=0; i<BENCH_MULTI; i++ ) {
+      sims[i]= new CCS811Sim(CCS811_SLAVEADDR_0+i/4, -1, b->appversion);
+      muxsim.attach(i%4,sims[i]);
+      muxbuses[i]= new CCS811MuxBus(&ccs811mux,i%4);
+      bench_multi[i]= new CCS811(-1, CCS811_SLAVEADDR_0+i/4, -1, muxbuses[i]);
+      bench_multi[i]->begin();
+      bench_multi[i]->start(CCS811_MODE_1SEC);
+    }
+    delay(1100);
+  }
+  if( b->prepare!=PREP_NONE && !mux ) {
+    ccs811.begin();
+    ccs811.start(b->prepare==PREP_RAW ? CCS811_MODE_250MS : CCS811_MODE_1SEC);
+    if( b->prepare!=PREP_NODATA && b->prepare!=PREP_MULTI ) delay(1100);
+    if( b->prepare==PREP_HWERROR ) sim.inject_error(0x10);
+    if( b->prepare==PREP_READ ) { call_read(ccs811); delay(1000); }
+  }
+  host_stats_reset();
+  uint64_t wake0= host_pin_low_us(NWAKE);
+  uint64_t t0= host_time_us();
+  bool ok= b->call(ccs811);
+  cost->starts= host_stats()->starts;
+  cost->bytes= host_stats()->bytes;
+  cost->wake_us= host_pin_low_us(NWAKE)-wake0;
+  cost->delay_us= host_stats()->delay_us;
+  cost->bus_us= host_stats()->bus_us;
+  cost->total_us= host_time_us()-t0;
+  Wire.bus()->detach(&sim);
+  for( int i=1; i<multi; i++ ) { Wire.bus()->detach(sims[i]); delete bench_multi[i]; delete sims[i]; }
+  if( mux ) {
+    Wire.bus()->detach(&muxsim);
+    for( int i=0; i<BENCH_MULTI; i++ ) { delete bench_multi[i]; delete muxbuses[i]; delete sims[i]; }
+  }
+  return ok;
+}
+
+
+// Budget check =======================================================================================================
+
+
+// Checks `cost` of benchmark `name` against the budget file. Lines: <name> <starts> <bytes> <wake_us> <delay_us>.
+// Returns false when over budget. Benchmarks without a budget line always pass.
+static bool bench_check(const char * budget, const char * name, const Cost * cost) {
+  FILE * f= fopen(budget,"r");
+  if( f==0 ) { fprintf(stderr,"bench: can not open '%s'\n",budget); return false; }
+  char line[128], bname[64];
+  unsigned long starts, bytes, wake_us, delay_us;
+  bool ok= true;
+  while( fgets(line,sizeof line,f) ) {
+    if( line[0]=='#' ) continue;
+    if( sscanf(line,"%63s %lu %lu %lu %lu",bname,&starts,&bytes,&wake_us,&delay_us)!=5 ) continue;
+    if( strcmp(bname,name)!=0 ) continue;
+    if( cost->starts>starts     ) { fprintf(stderr,"bench: %s: %u starts exceeds budget %lu\n",name,cost->starts,starts); ok= false; }
+    if( cost->bytes>bytes       ) { fprintf(stderr,"bench: %s: %u bytes exceeds budget %lu\n",name,cost->bytes,bytes); ok= false; }
+    if( cost->wake_us>wake_us   ) { fprintf(stderr,"bench: %s: %llu us nWAKE low exceeds budget %lu\n",name,(unsigned long long)cost->wake_us,wake_us); ok= false; }
+    if( cost->delay_us>delay_us ) { fprintf(stderr,"bench: %s: %llu us delay exceeds budget %lu\n",name,(unsigned long long)cost->delay_us,delay_us); ok= false; }
+  }
+  fclose(f);
+  return ok;
+}
+
+
+int main(int argc, char * argv[]) {
+  const char * budget= 0;
+  if( argc==3 && strcmp(argv[1],"--check")==0 ) budget= argv[2];
+  else if( argc!=1 ) { fprintf(stderr,"SYNTAX: ccs811bench [--check <budgetfile>]\n"); return 2; }
+
+  host_serial_enable(false);
+  Wire.begin();
+  bool pass= true;
+  printf("name,ok,starts,bytes,wake_us,delay_us,bus_us,total_us\n");
+  for( int i=0; i<BENCH_COUNT; i++ ) {
+    Cost cost;
+    bool ok= bench_run(&benches[i],&cost);
+    printf("%s,%d,%u,%u,%llu,%llu,%llu,%llu\n", benches[i].name, ok, cost.starts, cost.bytes,
+      (unsigned long long)cost.wake_us, (unsigned long long)cost.delay_us, (unsigned long long)cost.bus_us, (unsigned long long)cost.total_us);
+    if( !ok ) { fprintf(stderr,"bench: %s: call failed\n",benches[i].name); pass= false; }
+    if( budget && !bench_check(budget,benches[i].name,&cost) ) pass= false;
+  }
+  return pass ? 0 : 1;
+}
@@ -0,0 +1,56 @@
+/*
+  ccs811host.cpp - Runs the CCS811 driver against the simulated CCS811 on a PC, and reports the (virtual) time of each call.
+  2026 oct 17  v1  Created
+*/
+
+
+#include <stdio.h>
+#include "Arduino.h"
+#include "Wire.h"
+#include "host.h"
+#include "ccs811sim.h"
+#include "ccs811.h"
+
+
+// The firmware image as byte array in C
+#include "../../examples/ccs811flash/CCS811_FW_App_v2-0-0.h"
+
+
+#define NWAKE 3
+
+
+CCS811Sim sim(CCS811_SLAVEADDR_0, NWAKE, 0x1100);
+CCS811    ccs811(NWAKE);
+
+
+static uint64_t t0;
+static void tic(void) { t0= host_time_us(); }
+static void toc(const char * what, bool ok) { printf("host: %-28s %-6s %10llu us\n", what, ok?"ok":"FAILED", (unsigned long long)(host_time_us()-t0)); }
+
+
+int main(void) {
+  Wire.bus()->attach(&sim);
+  Wire.begin();
+  bool ok;
+
+  tic(); ok= ccs811.begin(); toc("begin()",ok);
+  printf("host: application version %X\n", ccs811.application_version());
+
+  host_serial_enable(false);
+  sim.set_flash_version(0x2000);
+  tic(); ok= ccs811.flash(image_data, sizeof(image_data)); toc("flash()",ok);
+  host_serial_enable(true);
+
+  tic(); ok= ccs811.begin(); toc("begin()",ok);
+  printf("host: application version %X\n", ccs811.application_version());
+
+  tic(); ok= ccs811.start(CCS811_MODE_1SEC); toc("start(CCS811_MODE_1SEC)",ok);
+  for( int i=0; i<5; i++ ) {
+    uint16_t eco2, etvoc, errstat, raw;
+    delay(1000);
+    tic(); ccs811.read(&eco2,&etvoc,&errstat,&raw); toc("read()",errstat==CCS811_ERRSTAT_OK);
+    printf("host: eco2=%u ppm  etvoc=%u ppb  errstat=%s\n", eco2, etvoc, ccs811.errstat_str(errstat));
+  }
+
+  return 0;
+}
@@ -0,0 +1,391 @@
+/*
+  ccs811sim.cpp - Register level simulator of the CCS811, to be attached to a simulated I2C bus (see host.h).
+  2026 oct 17  v6  Added busy_commands
+  2026 oct 17  v5  Added resets
+  2026 oct 17  v4  Added inject_nack
+  2026 oct 17  v3  Added threshold interrupts
+  2026 oct 17  v2  Added nINT
+  2026 oct 17  v1  Created
+*/
+
+
+#include <string.h>
+#include "Arduino.h"
+#include "ccs811sim.h"
+
+
+// CCS811 mailboxes (see datasheet)
+#define SIM_STATUS              0x00
+#define SIM_MEAS_MODE           0x01
+#define SIM_ALG_RESULT_DATA     0x02
+#define SIM_RAW_DATA            0x03
+#define SIM_ENV_DATA            0x05
+#define SIM_THRESHOLDS          0x10
+#define SIM_BASELINE            0x11
+#define SIM_HW_ID               0x20
+#define SIM_HW_VERSION          0x21
+#define SIM_FW_BOOT_VERSION     0x23
+#define SIM_FW_APP_VERSION      0x24
+#define SIM_ERROR_ID            0xE0
+#define SIM_APP_ERASE           0xF1
+#define SIM_APP_DATA            0xF2
+#define SIM_APP_VERIFY          0xF3
+#define SIM_APP_START           0xF4
+#define SIM_SW_RESET            0xFF
+
+
+// ERROR_ID flags
+#define SIM_ERR_WRITE_REG_INVALID  0x01
+#define SIM_ERR_READ_REG_INVALID   0x02
+#define SIM_ERR_MEASMODE_INVALID   0x04
+
+
+#define SIM_FLASH_SIZE          8192
+
+
+static const uint8_t sim_reset_key[4]= {0x11,0xE5,0x72,0x8A};
+static const uint8_t sim_erase_key[4]= {0xE7,0xA7,0xE6,0x09};
+
+
+// Construction and configuration =====================================================================================
+
+
+// Slave address, nWAKE pin (-1 when tied to GND), app firmware version (0 for none).
+CCS811Sim::CCS811Sim(int slaveaddr, int nwake, uint16_t appversion) {
+  _slaveaddr= slaveaddr;
+  _nwake= nwake;
+  _nint= -1;
+  _appversion= appversion;
+  _flashversion= 0x2000;
+  _eco2= 400;
+  _etvoc= 0;
+  timing.wake_us= 50;
+  timing.reset_us= 1500;
+  timing.appstart_us= 600;
+  timing.erase_us= 350000;
+  timing.verify_us= 45000;
+  timing.appdata_us= 25000;
+  _nacks= 0;
+  power_on();
+}
+
+
+// Power cycle: boot mode, all registers to default.
+void CCS811Sim::power_on(void) {
+  _appvalid= _appversion!=0;
+  _baseline[0]= 0x84; _baseline[1]= 0x3D;
+  _samples= 0;
+  _resets= 0;
+  _busycommands= 0;
+  _lost= 0;
+  _flashed= 0;
+  reset();
+  _busyuntil= 0; // Assume the host boots slower than the CCS811
+}
+
+
+// Base values of the generated samples.
+void CCS811Sim::set_air(uint16_t eco2, uint16_t etvoc) {
+  _eco2= eco2;
+  _etvoc= etvoc;
+}
+
+
+// App version reported after a successful flash.
+void CCS811Sim::set_flash_version(uint16_t appversion) {
+  _flashversion= appversion;
+}
+
+
+// Raises ERROR_ID flags (e.g. 0x10 heater fault).
+void CCS811Sim::inject_error(uint8_t errorid) {
+  _errorid|= errorid;
+}
+
+
+// The next `count` transfers (writes or reads) are not ACKed (and have no effect).
+void CCS811Sim::inject_nack(int count) {
+  _nacks= count;
+}
+
+
+// Connects nINT to host `pin` (-1, the default, for not connected).
+void CCS811Sim::set_nint(int pin) {
+  if( _nint>=0 ) host_pin_drive(_nint,HIGH);
+  _nint= pin;
+  nint_update();
+}
+
+
+// Inspection =========================================================================================================
+
+
+bool CCS811Sim::app_mode(void) {
+  return _app;
+}
+
+
+uint8_t CCS811Sim::meas_mode(void) {
+  return _measmode;
+}
+
+
+// Current STATUS register (without side effects).
+uint8_t CCS811Sim::status(void) {
+  uint8_t s= 0;
+  if( _app ) s|= 0x80;
+  if( !_app && _erased ) s|= 0x40;
+  if( !_app && _verified ) s|= 0x20;
+  if( _appvalid ) s|= 0x10;
+  if( _app && _dataready ) s|= 0x08;
+  if( _errorid ) s|= 0x01;
+  return s;
+}
+
+
+uint16_t CCS811Sim::app_version(void) {
+  return _appvalid ? _appversion : 0xFFFF;
+}
+
+
+const uint8_t * CCS811Sim::env_data(void) {
+  return _env;
+}
+
+
+const uint8_t * CCS811Sim::thresholds(void) {
+  return _thresholds;
+}
+
+
+uint16_t CCS811Sim::baseline(void) {
+  return _baseline[0]*256+_baseline[1];
+}
+
+
+int CCS811Sim::flashed(void) {
+  return _flashed;
+}
+
+
+uint32_t CCS811Sim::samples(void) {
+  return _samples;
+}
+
+
+uint32_t CCS811Sim::samples_lost(void) {
+  return _lost;
+}
+
+
+uint32_t CCS811Sim::resets(void) {
+  return _resets;
+}
+
+
+uint32_t CCS811Sim::busy_commands(void) {
+  return _busycommands;
+}
+
+
+// Internals ==========================================================================================================
+
+
+// nWAKE must be low (for timing.wake_us), and the device must not be busy
+bool CCS811Sim::awake(void) {
+  uint64_t now= host_time_us();
+  if( now<_busyuntil ) return false;
+  if( _nwake<0 ) return true;
+  return host_pin_level(_nwake)==LOW && now-host_pin_since_us(_nwake)>=timing.wake_us;
+}
+
+
+// The effect of SW_RESET: back to boot mode, measurement stopped
+void CCS811Sim::reset(void) {
+  _app= false;
+  _erased= false;
+  _verified= false;
+  _dataready= false;
+  _ptr= SIM_STATUS;
+  _measmode= 0;
+  _errorid= 0;
+  _samplenext= 0;
+  memset(_alg,0,sizeof _alg);
+  memset(_raw,0,sizeof _raw);
+  _env[0]= 0x64; _env[1]= 0x00; _env[2]= 0x64; _env[3]= 0x00; // 50%RH, 25C
+  _thresholds[0]= 1500>>8; _thresholds[1]= 1500&0xFF; _thresholds[2]= 2500>>8; _thresholds[3]= 2500&0xFF; _thresholds[4]= 50;
+  _band= 0;
+  _crossed= false;
+  _busyuntil= host_time_us()+timing.reset_us;
+  nint_update();
+}
+
+
+// nINT (open drain, active low) is asserted while INT_DATARDY is enabled and a sample is ready
+// (with INT_THRESH, only when that sample moved eCO2 to another band)
+void CCS811Sim::nint_update(void) {
+  if( _nint<0 ) return;
+  bool assert= _app && (_measmode&0x08) && _dataready && ( !(_measmode&0x04) || _crossed );
+  host_pin_drive(_nint, assert ? LOW : HIGH);
+}
+
+
+// Sample period of the current drive mode (0 for idle)
+uint32_t CCS811Sim::period_us(void) {
+  switch( (_measmode>>4)&7 ) {
+    case 1 : return 1000000;
+    case 2 : return 10000000;
+    case 3 : return 60000000;
+    case 4 : return 250000;
+  }
+  return 0;
+}
+
+
+// Produces a new sample; drive mode 4 only updates RAW_DATA
+void CCS811Sim::sample(void) {
+  if( _dataready ) _lost++;
+  _samples++;
+  uint16_t current= 20;                     // uA (6 bits)
+  uint16_t adc= 500 + (_samples*13)%17;     // 10 bits
+  _raw[0]= (current<<2) | (adc>>8);
+  _raw[1]= adc&0xFF;
+  if( ((_measmode>>4)&7)!=4 ) {
+    uint16_t eco2= _eco2 + (_samples*7)%11;
+    uint16_t etvoc= _etvoc + (_samples*3)%5;
+    _alg[0]= eco2>>8;  _alg[1]= eco2&0xFF;
+    _alg[2]= etvoc>>8; _alg[3]= etvoc&0xFF;
+    _alg[6]= _raw[0];  _alg[7]= _raw[1];
+    // Band tracking for INT_THRESH
+    uint16_t thr[2]= { (uint16_t)(_thresholds[0]*256+_thresholds[1]), (uint16_t)(_thresholds[2]*256+_thresholds[3]) };
+    uint8_t band= _band;
+    while( band<2 && eco2>thr[band]+_thresholds[4] ) band++;
+    while( band>0 && eco2+_thresholds[4]<thr[band-1] ) band--;
+    _crossed= band!=_band;
+    _band= band;
+  }
+  _dataready= true;
+  nint_update();
+}
+
+
+void CCS811Sim::tick(uint64_t now_us) {
+  uint32_t period= period_us();
+  if( !_app || period==0 ) return;
+  while( now_us>=_samplenext ) {
+    sample();
+    _samplenext+= period;
+  }
+}
+
+
+// HostI2CDevice ======================================================================================================
+
+
+bool CCS811Sim::claims(int addr) {
+  return addr==_slaveaddr;
+}
+
+
+bool CCS811Sim::write(int addr, const uint8_t * buf, int count) {
+  (void)addr;
+  if( !awake() ) {
+    if( host_time_us()<_busyuntil && count>0 && !(buf[0]==SIM_STATUS && count==1) ) _busycommands++;
+    return false;
+  }
+  if( _nacks>0 ) { _nacks--; return false; }
+  if( count==0 ) return true; // Ping
+  uint8_t reg= buf[0];
+  _ptr= reg;
+  if( reg==SIM_SW_RESET && count==5 ) {
+    if( memcmp(buf+1,sim_reset_key,4)==0 ) { reset(); _resets++; }
+    return true;
+  }
+  return _app ? write_app(reg,buf+1,count-1) : write_boot(reg,buf+1,count-1);
+}
+
+
+bool CCS811Sim::write_boot(uint8_t reg, const uint8_t * data, int n) {
+  uint64_t now= host_time_us();
+  if( reg==SIM_APP_START && n==0 ) {
+    if( _appvalid ) { _app= true; _busyuntil= now+timing.appstart_us; }
+  } else if( reg==SIM_APP_ERASE && n==4 ) {
+    if( memcmp(data,sim_erase_key,4)==0 ) {
+      _appvalid= false; _verified= false; _erased= true; _flashed= 0;
+      _busyuntil= now+timing.erase_us;
+    }
+  } else if( reg==SIM_APP_DATA && n>=1 && n<=8 ) {
+    if( _erased && _flashed+n<=SIM_FLASH_SIZE ) _flashed+= n; else _errorid|= SIM_ERR_WRITE_REG_INVALID;
+    _busyuntil= now+timing.appdata_us;
+  } else if( reg==SIM_APP_VERIFY && n==0 ) {
+    _verified= true;
+    _erased= false;
+    _appvalid= _flashed>0 && _flashed%8==0;
+    if( _appvalid ) _appversion= _flashversion;
+    _busyuntil= now+timing.verify_us;
+  } else if( n>0 ) {
+    _errorid|= SIM_ERR_WRITE_REG_INVALID;
+  }
+  return true;
+}
+
+
+bool CCS811Sim::write_app(uint8_t reg, const uint8_t * data, int n) {
+  if( n==0 ) return true; // Select mailbox for a subsequent read
+  if( reg==SIM_MEAS_MODE && n==1 ) {
+    uint8_t drive= (data[0]>>4)&7;
+    if( drive>4 || (data[0]&0x83) ) { _errorid|= SIM_ERR_MEASMODE_INVALID; return true; }
+    _measmode= data[0];
+    _samplenext= host_time_us()+period_us();
+    nint_update();
+  } else if( reg==SIM_ENV_DATA && (n==2 || n==4) ) {
+    memcpy(_env,data,n);
+  } else if( reg==SIM_THRESHOLDS && n==5 ) {
+    memcpy(_thresholds,data,5);
+  } else if( reg==SIM_BASELINE && n==2 ) {
+    memcpy(_baseline,data,2);
+  } else {
+    _errorid|= SIM_ERR_WRITE_REG_INVALID;
+  }
+  return true;
+}
+
+
+bool CCS811Sim::read(int addr, uint8_t * buf, int count) {
+  (void)addr;
+  if( !awake() ) return false;
+  if( _nacks>0 ) { _nacks--; return false; }
+  uint8_t reg[8];
+  int len= 0;
+  memset(reg,0,sizeof reg);
+  switch( _ptr ) {
+    case SIM_STATUS          : reg[0]= status(); len= 1; break;
+    case SIM_HW_ID           : reg[0]= 0x81; len= 1; break;
+    case SIM_HW_VERSION      : reg[0]= 0x12; len= 1; break;
+    case SIM_FW_BOOT_VERSION : reg[0]= 0x10; reg[1]= 0x00; len= 2; break;
+    case SIM_FW_APP_VERSION  : reg[0]= app_version()>>8; reg[1]= app_version()&0xFF; len= 2; break;
+    case SIM_ERROR_ID        : reg[0]= _errorid; len= 1; _errorid= 0; break;
+  }
+  if( len==0 && _app ) switch( _ptr ) {
+    case SIM_MEAS_MODE       : reg[0]= _measmode; len= 1; break;
+    case SIM_ALG_RESULT_DATA :
+      memcpy(reg,_alg,8);
+      reg[4]= status();
+      if( _appversion<0x2000 ) reg[4]&= ~0x08; // Pre 2.0.0 firmware has wrong STATUS in ALG_RESULT_DATA
+      reg[5]= _errorid;
+      len= 8;
+      _dataready= false;
+      _crossed= false;
+      break;
+    case SIM_RAW_DATA        :
+      memcpy(reg,_raw,2);
+      len= 2;
+      if( ((_measmode>>4)&7)==4 ) _dataready= false;
+      break;
+    case SIM_BASELINE        : memcpy(reg,_baseline,2); len= 2; break;
+  }
+  if( len==0 ) _errorid|= SIM_ERR_READ_REG_INVALID;
+  nint_update();
+  for( int i=0; i<count; i++ ) buf[i]= i<8 ? reg[i] : 0;
+  return true;
+}
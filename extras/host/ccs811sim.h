@@ -0,0 +1,103 @@
+/*
+  ccs811sim.h - Register level simulator of the CCS811, to be attached to a simulated I2C bus (see host.h).
+  It models the mailboxes, boot versus app mode, firmware flashing, nWAKE and the sample cadence of the drive modes.
+  2026 oct 17  v6  Added busy_commands
+  2026 oct 17  v5  Added resets
+  2026 oct 17  v4  Added inject_nack
+  2026 oct 17  v3  Added threshold interrupts
+  2026 oct 17  v2  Added nINT
+  2026 oct 17  v1  Created
+*/
+#ifndef _CCS811SIM_H_
+#define _CCS811SIM_H_
+
+
+#include <stdint.h>
+#include "host.h"
+
+
+// Timings of the simulated CCS811 (typical values, the driver waits the worst case).
+// While busy, the simulated CCS811 does not ACK its slave address. That is an assumption (the datasheet does not state it),
+// which adaptive timing relies on; a real part might ACK and drop the transfer, so a driver must only poll without side effects.
+// The selected mailbox survives nWAKE high (the datasheet does not say so; the driver does not rely on it).
+struct CCS811SimTiming {
+  uint32_t wake_us;                                                           // nWAKE must be low this long before an I2C START
+  uint32_t reset_us;                                                          // Busy after SW_RESET
+  uint32_t appstart_us;                                                       // Busy after APP_START
+  uint32_t erase_us;                                                          // Busy after APP_ERASE
+  uint32_t verify_us;                                                         // Busy after APP_VERIFY
+  uint32_t appdata_us;                                                        // Busy after APP_DATA
+};
+
+
+class CCS811Sim : public HostI2CDevice {
+  public: // Construction and configuration
+    CCS811Sim(int slaveaddr=0x5A, int nwake=-1, uint16_t appversion=0x2000); // Slave address, nWAKE pin (-1 when tied to GND), app firmware version (0 for none).
+    void power_on(void);                                                      // Power cycle: boot mode, all registers to default.
+    CCS811SimTiming timing;                                                   // Timing model, may be changed by the host.
+    void set_air(uint16_t eco2, uint16_t etvoc);                              // Base values of the generated samples.
+    void set_flash_version(uint16_t appversion);                              // App version reported after a successful flash.
+    void inject_error(uint8_t errorid);                                       // Raises ERROR_ID flags (e.g. 0x10 heater fault).
+    void inject_nack(int count);                                              // The next `count` transfers (writes or reads) are not ACKed (and have no effect).
+    void set_nint(int pin);                                                   // Connects nINT to host `pin` (-1, the default, for not connected).
+  public: // Inspection
+    bool     app_mode(void);                                                  // Is the firmware in application mode?
+    uint8_t  meas_mode(void);                                                 // Current MEAS_MODE register.
+    uint8_t  status(void);                                                    // Current STATUS register (without side effects).
+    uint16_t app_version(void);                                               // Current FW_APP_VERSION.
+    const uint8_t * env_data(void);                                           // The 4 ENV_DATA bytes.
+    const uint8_t * thresholds(void);                                         // The 5 THRESHOLDS bytes.
+    uint16_t baseline(void);                                                  // Current BASELINE.
+    int      flashed(void);                                                   // Number of bytes received via APP_DATA since last erase.
+    uint32_t samples(void);                                                   // Number of samples produced.
+    uint32_t samples_lost(void);                                              // Number of samples overwritten before being read.
+    uint32_t resets(void);                                                    // Number of SW_RESETs since power-on.
+    uint32_t busy_commands(void);                                             // Number of writes other than a STATUS select, NACKed because busy (a real part might have dropped them).
+  public: // HostI2CDevice
+    virtual bool claims(int addr);
+    virtual bool write(int addr, const uint8_t * buf, int count);
+    virtual bool read(int addr, uint8_t * buf, int count);
+    virtual void tick(uint64_t now_us);
+  private:
+    bool     awake(void);
+    void     reset(void);
+    void     sample(void);
+    void     nint_update(void);
+    uint32_t period_us(void);
+    bool     write_boot(uint8_t reg, const uint8_t * data, int n);
+    bool     write_app(uint8_t reg, const uint8_t * data, int n);
+  private:
+    int      _slaveaddr;
+    int      _nwake;
+    int      _nint;
+    uint16_t _appversion;
+    uint16_t _flashversion;
+    bool     _app;                                                            // In application mode
+    bool     _appvalid;
+    bool     _erased;
+    bool     _verified;
+    bool     _dataready;
+    uint8_t  _band;                                                           // eCO2 band (0=low, 1=medium, 2=high) for INT_THRESH
+    bool     _crossed;                                                        // The last sample moved eCO2 to another band
+    uint8_t  _ptr;                                                            // Mailbox selected by the last write
+    uint8_t  _measmode;
+    uint8_t  _errorid;
+    int      _nacks;                                                          // Transfers still to be NACKed (see inject_nack)
+    uint64_t _busyuntil;
+    uint64_t _samplenext;
+    uint32_t _samples;
+    uint32_t _resets;
+    uint32_t _busycommands;
+    uint32_t _lost;
+    uint16_t _eco2;
+    uint16_t _etvoc;
+    uint8_t  _alg[8];
+    uint8_t  _raw[2];
+    uint8_t  _env[4];
+    uint8_t  _thresholds[5];
+    uint8_t  _baseline[2];
+    int      _flashed;
+};
+
+
+#endif
@@ -0,0 +1,713 @@
+/*
+  ccs811test.cpp - Functional tests of the CCS811 driver against the simulated CCS811: returned values,
+  state of the simulated device, conversions and stored data (the bus cost is in ccs811bench.cpp).
+  Prints one line per test. Exits with 1 when a test fails.
+  2026 oct 17  v6  Checked the outputs of a read refused during a flash
+  2026 oct 17  v5  Added the Linux transport (one I2C_RDWR per read)
+  2026 oct 17  v4  Added read_begin during a flash
+  2026 oct 17  v3  Added mux reads (interleaved, and with the mailbox still selected)
+  2026 oct 17  v2  Added mailbox select that NACKs
+  2026 oct 17  v1  Created
+*/
+
+
+#include <stdio.h>
+#include <string.h>
+#include "Arduino.h"
+#include "Wire.h"
+#include "host.h"
+#include "ccs811sim.h"
+#include "linuxbussim.h"
+#include "ccs811.h"
+#include "ccs811manager.h"
+#include "ccs811mux.h"
+#include "muxsim.h"
+#include "linuxbussim.h"
+#include "ccs811unpack.h"
+#include "ccs811baseline.h"
+
+
+// The firmware image as byte array in C
+#include "../../examples/ccs811flash/CCS811_FW_App_v2-0-0.h"
+#include "../../examples/ccs811flash/CCS811_FW_App_v2-0-1.pack.h"
+
+
+#define NWAKE 3
+#define NINT  4
+#define MULTI 8
+
+
+// CCS811 mailboxes (for the I2C wrapper)
+#define REG_STATUS           0x00
+#define REG_ALG_RESULT_DATA  0x02
+
+
+// Fixtures ===========================================================================================================
+
+
+// Gives access to the I2C wrapper of the driver.
+class CCS811Probe : public CCS811 {
+  public:
+    CCS811Probe(int nwake) : CCS811(nwake) {}
+    using CCS811::i2cwrite;
+    using CCS811::i2cread;
+};
+
+
+// A fresh simulated CCS811 on Wire (nWAKE on NWAKE), with a fresh driver. When `started`: begin(), start(1SEC) and a sample ready.
+class Fixture {
+  public:
+    Fixture(uint16_t appversion=0x2000, bool started=true) : sim(CCS811_SLAVEADDR_0, NWAKE, appversion), ccs811(NWAKE) {
+      Wire.bus()->attach(&sim);
+      if( started ) { ccs811.begin(); ccs811.start(CCS811_MODE_1SEC); delay(1100); }
+    }
+    ~Fixture() { Wire.bus()->detach(&sim); }
+    CCS811Sim sim;
+    CCS811Probe ccs811;
+};
+
+
+// MULTI simulated CCS811s (nWAKE to GND) behind a TCA9548A; sensor i is on channel i%4. All begin() and start(1SEC).
+class MuxFixture {
+  public:
+    MuxFixture() : muxsim(CCS811MUX_SLAVEADDR), mux(0, CCS811MUX_SLAVEADDR) {
+      Wire.bus()->attach(&muxsim);
+      for( int i=0; i<MULTI; i++ ) {
+        sims[i]= new CCS811Sim(CCS811_SLAVEADDR_0+i/4, -1);
+        muxsim.attach(i%4,sims[i]);
+        buses[i]= new CCS811MuxBus(&mux,i%4);
+        sensors[i]= new CCS811(-1, CCS811_SLAVEADDR_0+i/4, -1, buses[i]);
+        sensors[i]->begin();
+        sensors[i]->start(CCS811_MODE_1SEC);
+      }
+    }
+    ~MuxFixture() {
+      Wire.bus()->detach(&muxsim);
+      for( int i=0; i<MULTI; i++ ) { delete sensors[i]; delete buses[i]; delete sims[i]; }
+    }
+    TCA9548ASim    muxsim;
+    CCS811Mux      mux;
+    CCS811Sim *    sims[MULTI];
+    CCS811MuxBus * buses[MULTI];
+    CCS811 *       sensors[MULTI];
+};
+
+
+// A store in RAM, that counts the writes per byte (for wear levelling).
+class RamStore : public CCS811Store {
+  public:
+    RamStore() : fail(false) { memset(mem,0xFF,sizeof mem); memset(wear,0,sizeof wear); }
+    virtual int  size(void) { return sizeof mem; }
+    virtual bool read(int addr, uint8_t * buf, int count) { memcpy(buf,mem+addr,count); return true; }
+    virtual bool write(int addr, const uint8_t * buf, int count) { if( fail ) return false; memcpy(mem+addr,buf,count); for( int i=0; i<count; i++ ) wear[addr+i]++; return true; }
+    bool     fail;                                                            // Writes fail (e.g. worn out)
+    uint8_t  mem[60];
+    uint32_t wear[60];
+};
+
+
+// A Stream over (the first `size` bytes of) the 2.0.0 image.
+class ImageStream : public Stream {
+  public:
+    ImageStream(int size) : _size(size), _pos(0) {}
+    virtual int available(void) { return _size-_pos; }
+    virtual int read(void) { return _pos<_size ? image_data[_pos++] : -1; }
+  private:
+    int _size;
+    int _pos;
+};
+
+
+// The eCO2 the simulator produces for its last sample, when its base eCO2 is `eco2`.
+static uint16_t sim_eco2(CCS811Sim & sim, uint16_t eco2) {
+  return eco2 + (sim.samples()*7)%11;
+}
+
+
+// Tests: read ========================================================================================================
+
+
+// A read returns the sample of the CCS811, with DATA_READY (firmware 2.x and pre 2.0)
+static bool read_values(uint16_t appversion) {
+  Fixture f(appversion,false);
+  f.sim.set_air(1000,50);
+  f.ccs811.begin(); f.ccs811.start(CCS811_MODE_1SEC); delay(1100);
+  uint16_t eco2, etvoc, errstat, raw;
+  f.ccs811.read(&eco2,&etvoc,&errstat,&raw);
+  return eco2==sim_eco2(f.sim,1000) && etvoc>=50 && etvoc<55 && (errstat&CCS811_ERRSTAT_DATA_READY) && (errstat&CCS811_ERRSTAT_ERRORS)==0;
+}
+static bool test_read_fw2000(void) { return read_values(0x2000); }
+static bool test_read_fw1100(void) { return read_values(0x1100); }
+
+
+// Consecutive reads skip selecting ALG_RESULT_DATA; after an access to another mailbox it is selected again
+static bool test_read_mailbox_cache(void) {
+  Fixture f(0x2000,false);
+  f.sim.set_air(1000,50);
+  f.ccs811.begin(); f.ccs811.start(CCS811_MODE_1SEC);
+  uint16_t eco2, errstat, baseline;
+  for( int i=0; i<3; i++ ) {
+    delay(1000);
+    if( i==2 && !f.ccs811.get_baseline(&baseline) ) return false;
+    f.ccs811.read(&eco2,0,&errstat,0);
+    if( eco2!=sim_eco2(f.sim,1000) || (errstat&CCS811_ERRSTAT_DATA_READY)==0 ) return false;
+  }
+  return true;
+}
+
+
+// A mailbox select that is not ACKed leaves the previous mailbox selected; the next read of it must select it again
+static bool test_read_mailbox_nack(void) {
+  Fixture f;
+  uint8_t buf[8], status;
+  CCS811WakeSession session(f.ccs811);
+  if( !f.ccs811.i2cread(REG_ALG_RESULT_DATA,8,buf) ) return false;
+  f.sim.inject_nack(1);
+  if( f.ccs811.i2cwrite(REG_STATUS,0,0) ) return false;
+  return f.ccs811.i2cread(REG_STATUS,1,&status) && status==f.sim.status();
+}
+
+
+// The field-selective read returns the same eCO2
+static bool test_read_eco2_only(void) {
+  Fixture f;
+  uint16_t eco2;
+  f.ccs811.read(&eco2,0,0,0);
+  return eco2==sim_eco2(f.sim,400);
+}
+
+
+// A hardware error is reported (and cleared from ERROR_ID)
+static bool test_read_hwerror(void) {
+  Fixture f;
+  f.sim.inject_error(0x10);
+  uint16_t eco2, etvoc, errstat, raw;
+  f.ccs811.read(&eco2,&etvoc,&errstat,&raw);
+  return (errstat&CCS811_ERRSTAT_HEATER_FAULT) && (errstat&CCS811_ERRSTAT_ERROR);
+}
+
+
+// A failed read_raw() returns 0 (as read()), not stale or uninitialized bytes
+static bool test_read_raw_fail(void) {
+  Fixture f(0x2000,false);
+  uint16_t raw;
+  if( !f.ccs811.begin() || !f.ccs811.start(CCS811_MODE_250MS) ) return false;
+  delay(300);
+  if( !f.ccs811.read_raw(&raw) || raw==0 ) return false;
+  f.sim.inject_nack(1);
+  return !f.ccs811.read_raw(&raw) && raw==0;
+}
+
+
+// The non-blocking read returns the same as read()
+static bool test_read_poll(void) {
+  Fixture f;
+  uint16_t eco2, etvoc, errstat, raw;
+  f.ccs811.read_begin();
+  while( !f.ccs811.read_poll(&eco2,&etvoc,&errstat,&raw) ) host_advance_us(10);
+  return eco2==sim_eco2(f.sim,400) && (errstat&CCS811_ERRSTAT_DATA_READY) && (errstat&CCS811_ERRSTAT_ERRORS)==0;
+}
+
+
+// A non-blocking read without new data returns 0s (as read()), not the fields of the previous read (pre 2.0.0 reads STATUS first)
+static bool test_read_poll_nodata(void) {
+  Fixture f(0x1100);
+  uint16_t eco2, etvoc, errstat, raw;
+  f.ccs811.read_begin();
+  while( !f.ccs811.read_poll(&eco2,&etvoc,&errstat,&raw) ) host_advance_us(10);
+  if( eco2!=sim_eco2(f.sim,400) || raw==0 ) return false;
+  f.ccs811.read_begin();
+  while( !f.ccs811.read_poll(&eco2,&etvoc,&errstat,&raw) ) host_advance_us(10);
+  return errstat==CCS811_ERRSTAT_OK_NODATA && eco2==0 && etvoc==0 && raw==0;
+}
+
+
+// The selected mailbox is only cached while awake: a read after nWAKE went high, or after set_envdata(), selects ALG_RESULT_DATA again
+static bool test_read_mailbox_wake(void) {
+  Fixture f;
+  uint16_t eco2, etvoc, errstat, raw;
+  f.ccs811.read(&eco2,&etvoc,&errstat,&raw);
+  host_stats_reset();
+  f.ccs811.read(&eco2,&etvoc,&errstat,&raw);
+  if( host_stats()->starts!=2 ) return false; // nWAKE was high in between: select and read
+  CCS811WakeSession session(f.ccs811);
+  f.ccs811.read(&eco2,&etvoc,&errstat,&raw);
+  host_stats_reset();
+  f.ccs811.read(&eco2,&etvoc,&errstat,&raw);
+  if( host_stats()->starts!=1 ) return false; // Same wake session: read only
+  if( !f.ccs811.set_envdata(0x6000,0x6000) ) return false;
+  host_stats_reset();
+  f.ccs811.read(&eco2,&etvoc,&errstat,&raw);
+  return host_stats()->starts==2 && (errstat&CCS811_ERRSTAT_ERRORS)==0;
+}
+
+
+// Tests: Linux transport =============================================================================================
+
+
+// The driver works over /dev/i2c-N: a register read is one I2C_RDWR with a write and a read message, and select() plus fetch() gives the same bytes
+static bool test_linux_read(void) {
+  Fixture f(0x2000,false);
+  f.sim.set_air(1000,50);
+  CCS811LinuxBusSim linuxbus(Wire.bus());
+  CCS811 ccs811(NWAKE, CCS811_SLAVEADDR_0, -1, &linuxbus);
+  if( !ccs811.begin() || !ccs811.start(CCS811_MODE_1SEC) ) return false;
+  delay(1100);
+  uint16_t eco2, etvoc, errstat, raw;
+  ccs811.read(&eco2,&etvoc,&errstat,&raw);
+  if( eco2!=sim_eco2(f.sim,1000) || (errstat&CCS811_ERRSTAT_ERRORS)!=0 ) return false;
+  CCS811WakeSession session(ccs811);
+  uint8_t one[8], two[8];
+  uint32_t transfers= linuxbus.transfers(), messages= linuxbus.messages();
+  if( !linuxbus.read(CCS811_SLAVEADDR_0,REG_ALG_RESULT_DATA,8,one,0) ) return false;
+  if( linuxbus.transfers()!=transfers+1 || linuxbus.messages()!=messages+2 ) return false;
+  if( !linuxbus.select(CCS811_SLAVEADDR_0,REG_ALG_RESULT_DATA) || !linuxbus.fetch(CCS811_SLAVEADDR_0,8,two) ) return false;
+  // Same sample (STATUS in byte 4 may lose DATA_READY, it was just read)
+  return one[0]*256+one[1]==eco2 && memcmp(one,two,4)==0 && memcmp(one+5,two+5,3)==0;
+}
+
+
+// Tests: ENV_DATA ====================================================================================================
+
+
+// Integer ENV_DATA conversion is never off by more than rounding from the (clipped) float formula (-40C..85C, 0..100%RH per milli unit)
+static bool test_envdata_conversion(void) {
+  for( int32_t t=-40000; t<=85000; t++ ) { double f= (t/1000.0+25)*512; if( f<0 ) f= 0; if( CCS811::envdata_t_mCelsius(t)<f-0.5 || CCS811::envdata_t_mCelsius(t)>f+0.5 ) return false; }
+  for( int32_t h=0; h<=100000; h++ ) { double f= h/1000.0*512; if( CCS811::envdata_h_mpercRH(h)<f-0.5 || CCS811::envdata_h_mpercRH(h)>f+0.5 ) return false; }
+  return true;
+}
+
+
+// All set_envdata variants write the same ENV_DATA for 23.5C and 48.5%RH (0x6100, 0x6100)
+static bool test_envdata_variants(void) {
+  static const uint8_t expect[4]= { 0x61, 0x00, 0x61, 0x00 };
+  Fixture f;
+  if( !f.ccs811.set_envdata_mCelsius_mpercRH(23500,48500) || memcmp(f.sim.env_data(),expect,4)!=0 ) return false;
+  if( !f.ccs811.set_envdata(0,0) || !f.ccs811.set_envdata_Celsius_percRH(23.5,48.5) || memcmp(f.sim.env_data(),expect,4)!=0 ) return false;
+  // ENS210: 23.5C is 296.65K, in 1/64 K that is 18985.6; 48.5%RH in 1/512 %RH is 0x6100
+  if( !f.ccs811.set_envdata(0,0) || !f.ccs811.set_envdata210(18986,0x6100) ) return false;
+  return f.sim.env_data()[0]==0x61 && f.sim.env_data()[1]==0x00 && f.sim.env_data()[2]==0x61;
+}
+
+
+// With a dead-band of 0.5C, 1%RH and 30s, a T/H sample per second (small jitter, 1C step at 40s) is written 3 times in 60s
+static bool test_envdata_deadband(void) {
+  Fixture f;
+  f.ccs811.set_envdata_deadband(256,512,30000);
+  for( int s=0; s<60; s++ ) {
+    if( !f.ccs811.set_envdata_mCelsius_mpercRH(23000+(s%5)*25+(s>=40?1000:0),48000+(s%3)*200) ) return false;
+    delay(1000);
+  }
+  return f.ccs811.get_envdata_suppressed()==57 && f.sim.env_data()[2]==0x62 && f.sim.env_data()[3]==0x00; // 24.0C, written at 40s
+}
+
+
+// A maxage_ms of 0 is no maximum age: an unchanged T/H is never written again; all 0 writes always
+static bool test_envdata_deadband_nomaxage(void) {
+  Fixture f;
+  f.ccs811.set_envdata_deadband(256,512,0);
+  for( int s=0; s<60; s++ ) {
+    if( !f.ccs811.set_envdata(0x6000,0x6000) ) return false;
+    delay(60000);
+  }
+  if( f.ccs811.get_envdata_suppressed()!=59 ) return false;
+  f.ccs811.set_envdata_deadband(0,0,0);
+  for( int s=0; s<3; s++ ) if( !f.ccs811.set_envdata(0x6000,0x6000) ) return false;
+  return f.ccs811.get_envdata_suppressed()==59;
+}
+
+
+// The manager writes ENV_DATA of all sensors behind the mux
+static bool test_envdata_fanout(void) {
+  MuxFixture m;
+  CCS811Manager mgr;
+  for( int i=0; i<MULTI; i++ ) mgr.add(m.sensors[i]);
+  uint32_t writes= m.muxsim.writes();
+  if( mgr.set_envdata_mCelsius_mpercRH(23500,48500)!=MULTI ) return false;
+  for( int i=0; i<MULTI; i++ ) if( m.sims[i]->env_data()[0]!=0x61 || m.sims[i]->env_data()[2]!=0x61 ) return false;
+  return m.muxsim.writes()-writes<=4; // at most one select per channel
+}
+
+
+// Tests: mux =======================================================================================================
+
+
+// Reads alternate between channels, also when the mailbox is still selected (a fetch on its own selects the channel)
+static bool test_mux_alternate(void) {
+  MuxFixture m;
+  for( int s=0; s<3; s++ ) {
+    delay(1000);
+    for( int i=0; i<MULTI; i++ ) {
+      uint16_t eco2, errstat;
+      m.sensors[i]->read(&eco2,0,&errstat,0);
+      if( eco2!=sim_eco2(*m.sims[i],400) || (errstat&CCS811_ERRSTAT_ERRORS) ) return false;
+    }
+  }
+  return true;
+}
+
+
+// A non-blocking read interleaved with one on another channel fails (the mux is not switched between its select and fetch)
+static bool test_mux_interleaved(void) {
+  MuxFixture m;
+  delay(1100);
+  uint16_t eco2, etvoc, errstat0, errstat1, raw;
+  m.sensors[0]->read_begin();
+  m.sensors[1]->read_begin();
+  m.sensors[0]->read_poll(&eco2,&etvoc,&errstat0,&raw); // Selects ALG_RESULT_DATA on channel 0
+  m.sensors[1]->read_poll(&eco2,&etvoc,&errstat1,&raw); // Selects ALG_RESULT_DATA on channel 1
+  while( !m.sensors[0]->read_poll(&eco2,&etvoc,&errstat0,&raw) ) host_advance_us(10);
+  while( !m.sensors[1]->read_poll(&eco2,&etvoc,&errstat1,&raw) ) host_advance_us(10);
+  return m.muxsim.control()==0x02 && (errstat0&CCS811_ERRSTAT_I2CFAIL) && (errstat1&CCS811_ERRSTAT_ERRORS)==0 && eco2==sim_eco2(*m.sims[1],400);
+}
+
+
+// Tests: wake sessions ===============================================================================================
+
+
+// Nested wake sessions share one nWAKE cycle: calls in between do not toggle nWAKE, only the outermost wake_end() releases it
+static bool test_wake_nested(void) {
+  Fixture f;
+  if( host_pin_level(NWAKE)!=HIGH ) return false;
+  f.ccs811.wake_begin();
+  uint64_t low_since= host_pin_since_us(NWAKE);
+  if( host_pin_level(NWAKE)!=LOW ) return false;
+  f.ccs811.wake_begin();
+  delay(1);
+  bool ok= f.ccs811.hardware_version()==0x12 && f.ccs811.application_version()==0x2000;
+  uint16_t eco2, etvoc, errstat, raw;
+  f.ccs811.read(&eco2,&etvoc,&errstat,&raw);
+  f.ccs811.wake_end();
+  if( !ok || errstat!=CCS811_ERRSTAT_OK || host_pin_level(NWAKE)!=LOW || host_pin_since_us(NWAKE)!=low_since ) return false;
+  f.ccs811.wake_end();
+  if( host_pin_level(NWAKE)!=HIGH ) return false;
+  f.ccs811.wake_end(); // Unbalanced: ignored
+  f.ccs811.wake_begin();
+  bool low= host_pin_level(NWAKE)==LOW;
+  f.ccs811.wake_end();
+  return low && host_pin_level(NWAKE)==HIGH;
+}
+
+
+// Tests: interrupts ==================================================================================================
+
+
+// With nINT, data_ready() is false before the first sample, true once it is there, and false again after the read
+static bool test_nint_data_ready(void) {
+  Fixture f(0x2000,false);
+  f.sim.set_nint(NINT);
+  CCS811 c(NWAKE,CCS811_SLAVEADDR_0,NINT);
+  if( !c.begin() || !c.start(CCS811_MODE_1SEC) ) return false;
+  if( c.data_ready() ) return false;
+  delay(1100);
+  if( !c.data_ready() ) return false;
+  uint16_t eco2, etvoc, errstat, raw;
+  c.read(&eco2,&etvoc,&errstat,&raw);
+  return errstat==CCS811_ERRSTAT_OK && !c.data_ready();
+}
+
+
+// With thresholds, nINT stays high while eCO2 stays in its band, and signals once when it moves to the next band
+static bool test_nint_thresh(void) {
+  Fixture f(0x2000,false);
+  f.sim.set_nint(NINT);
+  CCS811 c(NWAKE,CCS811_SLAVEADDR_0,NINT);
+  if( !c.begin() || !c.set_thresholds(1500,2500,50) || !c.start(CCS811_MODE_1SEC) ) return false;
+  int low= 0, medium= 0;
+  for( int t=0; t<60000; t+=10 ) {
+    if( t==30000 ) f.sim.set_air(1600,100);
+    if( c.data_ready() ) {
+      uint16_t eco2, etvoc, errstat, raw;
+      c.read(&eco2,&etvoc,&errstat,&raw);
+      if( eco2<1500 ) low++; else medium++;
+    }
+    delay(10);
+  }
+  return low==0 && medium==1 && f.sim.samples()>=59;
+}
+
+
+// Tests: warm start ==================================================================================================
+
+
+// A running CCS811 keeps running in its mode; a fresh one falls back to begin()
+static bool test_begin_warm_running(void) {
+  Fixture f;
+  CCS811 again(NWAKE);
+  return again.begin_warm() && again.get_mode()==CCS811_MODE_1SEC && f.sim.meas_mode()==(CCS811_MODE_1SEC<<4) && f.sim.samples()>0 && f.sim.resets()==1;
+}
+static bool test_begin_warm_cold(void) {
+  Fixture f(0x2000,false);
+  return f.ccs811.begin_warm() && f.ccs811.get_mode()==CCS811_MODE_IDLE && f.sim.app_mode();
+}
+
+
+// An idle CCS811 has nothing to resume: cold start
+static bool test_begin_warm_idle(void) {
+  Fixture f(0x2000,false);
+  if( !f.ccs811.begin() ) return false;
+  CCS811 again(NWAKE);
+  return again.begin_warm() && again.get_mode()==CCS811_MODE_IDLE && f.sim.resets()==2;
+}
+
+
+// A resume rewrites interrupt flags that differ from what start() writes: INT_THRESH left by a host that set thresholds
+static bool test_begin_warm_thresh(void) {
+  Fixture f(0x2000,false);
+  f.sim.set_nint(NINT);
+  {
+    CCS811 first(NWAKE,CCS811_SLAVEADDR_0,NINT);
+    if( !first.begin() || !first.set_thresholds(1500,2500) || !first.start(CCS811_MODE_1SEC) ) return false;
+  }
+  if( f.sim.meas_mode()!=((CCS811_MODE_1SEC<<4)|0x0C) ) return false;
+  CCS811 again(NWAKE,CCS811_SLAVEADDR_0,NINT);
+  return again.begin_warm() && again.get_mode()==CCS811_MODE_1SEC && f.sim.meas_mode()==((CCS811_MODE_1SEC<<4)|0x08) && f.sim.resets()==1;
+}
+
+
+// Tests: baseline ====================================================================================================
+
+
+// First power-up: nothing stored, saved once after 24h20m
+static bool test_baseline_save(void) {
+  Fixture f;
+  RamStore store;
+  CCS811Baseline baseline(&f.ccs811,&store);
+  baseline.begin();
+  int saved= 0;
+  for( int s=0; s<25*60*60; s++ ) { if( baseline.poll()==CCS811BASELINE_SAVED ) saved++; delay(1000); }
+  uint16_t b;
+  return saved==1 && baseline.writes()==1 && baseline.stored(&b) && b==f.sim.baseline();
+}
+
+
+// Next power-up: the stored baseline (0x1234, in slot 0) is restored after the 20 minute warm-up
+static bool test_baseline_restore(void) {
+  Fixture f;
+  RamStore store;
+  const uint8_t slot[CCS811BASELINE_SLOT_SIZE]= { 0x00, 0x01, 0x12, 0x34, 0x27 }; // seq 1, baseline 0x1234, CRC-8
+  store.write(0,slot,sizeof slot);
+  CCS811Baseline baseline(&f.ccs811,&store);
+  baseline.begin();
+  int restored= 0;
+  for( int s=0; s<21*60; s++ ) { if( baseline.poll()==CCS811BASELINE_RESTORED ) restored++; delay(1000); }
+  return restored==1 && f.sim.baseline()==0x1234;
+}
+
+
+// After a resumed begin_warm(), the newer baseline in the CCS811 is not overwritten by the stored one
+static bool test_baseline_resume(void) {
+  Fixture f;
+  RamStore store;
+  const uint8_t slot[CCS811BASELINE_SLOT_SIZE]= { 0x00, 0x01, 0x12, 0x34, 0x27 }; // seq 1, baseline 0x1234, CRC-8
+  store.write(0,slot,sizeof slot);
+  CCS811 again(NWAKE);
+  if( !again.begin_warm() || again.get_mode()==CCS811_MODE_IDLE ) return false;
+  uint16_t running= f.sim.baseline();
+  CCS811Baseline baseline(&again,&store);
+  baseline.begin(false);
+  for( int s=0; s<21*60; s++ ) { if( baseline.poll()!=CCS811BASELINE_NONE ) return false; delay(1000); }
+  return f.sim.baseline()==running && running!=0x1234;
+}
+
+
+// A save that fails (reading the baseline, or writing the store) is retried after CCS811BASELINE_RETRY_MS, not a period later
+static bool test_baseline_retry(void) {
+  Fixture f;
+  RamStore store;
+  CCS811Baseline baseline(&f.ccs811,&store);
+  baseline.set_times(0,CCS811BASELINE_PERIOD_MS);
+  baseline.begin();
+  if( baseline.poll()!=CCS811BASELINE_NONE ) return false;
+  delay(CCS811BASELINE_PERIOD_MS);
+  f.sim.inject_nack(1);
+  if( baseline.poll()!=CCS811BASELINE_FAILED ) return false;
+  delay(1000);
+  if( baseline.poll()!=CCS811BASELINE_NONE ) return false;
+  store.fail= true;
+  delay(CCS811BASELINE_RETRY_MS);
+  if( baseline.poll()!=CCS811BASELINE_FAILED ) return false;
+  store.fail= false;
+  delay(CCS811BASELINE_RETRY_MS);
+  if( baseline.poll()!=CCS811BASELINE_SAVED || baseline.writes()!=1 ) return false;
+  delay(CCS811BASELINE_RETRY_MS);
+  return baseline.poll()==CCS811BASELINE_NONE;
+}
+
+
+// Many saves (the sequence number wraps) spread evenly over the slots; the newest wins; a torn newest slot falls back to the previous
+static bool test_baseline_wear(void) {
+  Fixture f;
+  RamStore store;
+  CCS811Baseline baseline(&f.ccs811,&store);
+  baseline.set_times(0,1000);
+  baseline.begin();
+  for( uint32_t i=0; i<70000; i++ ) { if( !f.ccs811.set_baseline(0x1000+i) || !baseline.save() ) return false; }
+  uint32_t lo= 0xFFFFFFFF, hi= 0;
+  for( int i=0; i<store.size(); i++ ) { if( store.wear[i]<lo ) lo= store.wear[i]; if( store.wear[i]>hi ) hi= store.wear[i]; }
+  if( hi-lo>1 ) return false;
+  uint16_t b, newest= (0x1000+69999)&0xFFFF;
+  CCS811Baseline again(&f.ccs811,&store);
+  again.begin();
+  if( !again.stored(&b) || b!=newest ) return false;
+  for( int s=0; s<store.size()/CCS811BASELINE_SLOT_SIZE; s++ ) {
+    uint8_t * slot= store.mem+s*CCS811BASELINE_SLOT_SIZE;
+    if( slot[2]==(newest>>8) && slot[3]==(newest&0xFF) ) slot[3]^= 0x01;
+  }
+  CCS811Baseline torn(&f.ccs811,&store);
+  torn.begin();
+  return torn.stored(&b) && b==newest-1;
+}
+
+
+// Tests: flash =======================================================================================================
+
+
+// Flash from a Stream; a stream that ends early fails the flash
+static bool test_flash_stream(void) {
+  Fixture f(0x1100,false);
+  ImageStream shortstream(sizeof(image_data)-10);
+  if( f.ccs811.flash(shortstream,sizeof(image_data)) ) return false;
+  ImageStream stream(sizeof(image_data));
+  return f.ccs811.flash(stream,sizeof(image_data)) && f.ccs811.begin() && f.ccs811.application_version()==0x2000;
+}
+
+
+// Adaptive timing polls without side effects: no command (APP_DATA, APP_VERIFY, ...) is sent while the CCS811 is busy
+static bool test_flash_adaptive(void) {
+  Fixture f(0x1100,false);
+  f.ccs811.set_adaptive_timing(true);
+  if( !f.ccs811.flash(image_data,sizeof(image_data)) ) return false;
+  CCS811Timing timing;
+  f.ccs811.get_timing(&timing);
+  return f.sim.flashed()==(int)sizeof(image_data) && f.sim.busy_commands()==0 && timing.appdata_us>0 && timing.appdata_us<f.sim.timing.appdata_us*2;
+}
+
+
+// A non-blocking read can not begin while a non-blocking flash is in progress (and vice versa); the refused one leaves outputs and flash untouched
+static bool test_flash_read_exclusive(void) {
+  Fixture f(0x1100,false);
+  f.sim.set_air(1000,50);
+  if( !f.ccs811.flash_begin(image_data,sizeof(image_data)) || f.ccs811.read_begin() || f.ccs811.flash_begin(image_data,sizeof(image_data)) ) return false;
+  uint16_t eco2=0xBEEF, etvoc=0xBEEF, errstat=0xBEEF, raw=0xBEEF;
+  int res;
+  while( (res=f.ccs811.flash_poll())==CCS811_FLASH_BUSY ) {
+    if( f.ccs811.read_poll(&eco2,&etvoc,&errstat,&raw) ) return false;
+    delay(1);
+  }
+  if( eco2!=0xBEEF || etvoc!=0xBEEF || errstat!=0xBEEF || raw!=0xBEEF ) return false;
+  if( res!=CCS811_FLASH_DONE || f.sim.flashed()!=(int)sizeof(image_data) || !f.ccs811.begin() || !f.ccs811.start(CCS811_MODE_1SEC) ) return false;
+  delay(1100);
+  if( !f.ccs811.read_begin() || f.ccs811.flash_begin(image_data,sizeof(image_data)) ) return false;
+  while( !f.ccs811.read_poll(&eco2,&etvoc,&errstat,&raw) ) host_advance_us(10);
+  return eco2==sim_eco2(f.sim,1000) && (errstat&CCS811_ERRSTAT_DATA_READY) && (errstat&CCS811_ERRSTAT_ERRORS)==0;
+}
+
+
+// An image container is flashed, skipped when installed, and rejected when corrupt (without I2C)
+static bool test_flash_image(void) {
+  Fixture f(0x1100,false);
+  if( f.ccs811.flash_image(image_header,image_data)!=CCS811_IMAGE_FLASHED || f.sim.flashed()!=(int)sizeof(image_data) ) return false;
+  if( !f.ccs811.begin() || f.ccs811.flash_image(image_header,image_data)!=CCS811_IMAGE_SKIPPED ) return false;
+  uint8_t header[CCS811_IMAGE_HEADER_SIZE];
+  memcpy(header,image_header,sizeof header);
+  header[11]^= 0x01; // CRC
+  host_stats_reset();
+  return f.ccs811.flash_image(header,image_data,true)==CCS811_IMAGE_INVALID && host_stats()->starts==0;
+}
+
+
+// An installed version is not skipped when STATUS reports an ERROR (e.g. after a failed flash)
+static bool test_flash_image_error(void) {
+  Fixture f(0x2000,false);
+  uint8_t byte= 0;
+  if( !f.ccs811.begin() ) return false;
+  { CCS811WakeSession session(f.ccs811); f.ccs811.i2cwrite(0xF2,1,&byte); } // APP_DATA in app mode: WRITE_REG_INVALID
+  if( f.ccs811.application_version()!=0x2000 || !(f.sim.status()&CCS811_ERRSTAT_ERROR) ) return false;
+  return f.ccs811.flash_image(image_header,image_data)==CCS811_IMAGE_FLASHED && f.sim.flashed()==(int)sizeof(image_data);
+}
+
+
+// The 2.0.1 container packed against 2.0.0 unpacks to the right image (flash_image checks the CRC)
+static bool test_flash_image_packed(void) {
+  Fixture f(0x1100,false);
+  CCS811Unpack unpack(packed_data, sizeof(packed_data), image_data, sizeof(image_data));
+  unpack.set_header(packed_header);
+  return f.ccs811.flash_image(CCS811Unpack::reader,&unpack)==CCS811_IMAGE_FLASHED && f.sim.flashed()==(int)packed_imagesize;
+}
+
+
+// The manager flashes all sensors
+static bool test_flash_manager(void) {
+  MuxFixture m;
+  CCS811Manager mgr;
+  for( int i=0; i<MULTI; i++ ) mgr.add(m.sensors[i]);
+  if( mgr.flash(image_data,sizeof(image_data))!=MULTI ) return false;
+  for( int i=0; i<MULTI; i++ ) if( m.sims[i]->flashed()!=(int)sizeof(image_data) ) return false;
+  return true;
+}
+
+
+// Main ===============================================================================================================
+
+
+struct Test {
+  const char * name;
+  bool       (*test)(void);
+};
+
+
+static const Test tests[]= {
+  { "read/fw2000",               test_read_fw2000 },
+  { "read/fw1100",               test_read_fw1100 },
+  { "read/mailbox_cache",        test_read_mailbox_cache },
+  { "read/mailbox_wake",         test_read_mailbox_wake },
+  { "read/mailbox_nack",         test_read_mailbox_nack },
+  { "read/eco2_only",            test_read_eco2_only },
+  { "read/hwerror",              test_read_hwerror },
+  { "read_raw/fail",             test_read_raw_fail },
+  { "read_poll",                 test_read_poll },
+  { "read_poll/nodata",          test_read_poll_nodata },
+  { "linux/read",                test_linux_read },
+  { "envdata/conversion",        test_envdata_conversion },
+  { "envdata/variants",          test_envdata_variants },
+  { "envdata/deadband",          test_envdata_deadband },
+  { "envdata/deadband/nomaxage", test_envdata_deadband_nomaxage },
+  { "envdata/fanout",            test_envdata_fanout },
+  { "mux/alternate",             test_mux_alternate },
+  { "mux/interleaved",           test_mux_interleaved },
+  { "wake/nested",               test_wake_nested },
+  { "nint/data_ready",           test_nint_data_ready },
+  { "nint/thresh",               test_nint_thresh },
+  { "begin_warm/running",        test_begin_warm_running },
+  { "begin_warm/cold",           test_begin_warm_cold },
+  { "begin_warm/idle",           test_begin_warm_idle },
+  { "begin_warm/thresh",         test_begin_warm_thresh },
+  { "baseline/save",             test_baseline_save },
+  { "baseline/restore",          test_baseline_restore },
+  { "baseline/resume",           test_baseline_resume },
+  { "baseline/retry",            test_baseline_retry },
+  { "baseline/wear",             test_baseline_wear },
+  { "flash/stream",              test_flash_stream },
+  { "flash/adaptive",            test_flash_adaptive },
+  { "flash/read_exclusive",      test_flash_read_exclusive },
+  { "flash_image",               test_flash_image },
+  { "flash_image/error",         test_flash_image_error },
+  { "flash_image/packed",        test_flash_image_packed },
+  { "flash/manager",             test_flash_manager },
+};
+#define TEST_COUNT ( (int)(sizeof(tests)/sizeof(tests[0])) )
+
+
+int main(void) {
+  host_serial_enable(false);
+  Wire.begin();
+  int failed= 0;
+  for( int i=0; i<TEST_COUNT; i++ ) {
+    bool ok= tests[i].test();
+    printf("test: %-28s %s\n", tests[i].name, ok ? "ok" : "FAILED");
+    if( !ok ) failed++;
+  }
+  printf("test: %d of %d passed\n", TEST_COUNT-failed, TEST_COUNT);
+  return failed ? 1 : 0;
+}
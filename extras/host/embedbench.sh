@@ -0,0 +1,41 @@
+#!/bin/sh
+# embedbench.sh - compares two ways to embed the firmware images: hex literals (hex.py) versus #embed/.incbin (hex.py --embed).
+# For each way, it builds the three images, one translation unit per image, and prints per image and in total
+# the size of the header, the size of the preprocessed translation unit, and the compile time (best of RUNS).
+# 2026 oct 17  v1  Created
+
+CXX=${CXX:-g++}
+RUNS=${RUNS:-5}
+FLASH=../../examples/ccs811flash
+DIR=_embed
+mkdir -p $DIR
+
+# Prints the current time in ms
+now_ms() { echo $(( $(date +%s%N) / 1000000 )); }
+
+echo "way,image,header_bytes,preprocessed_bytes,compile_ms"
+for way in hex embed; do
+  total_h=0; total_i=0; total_ms=0
+  for v in 1-0-0 2-0-0 2-0-1; do
+    bin=$(cd $FLASH && pwd)/CCS811_FW_App_v$v.bin
+    hdr=$DIR/CCS811_FW_App_v$v.$way.h
+    if [ $way = hex ]; then python3 $FLASH/hex.py $bin > $hdr; else python3 $FLASH/hex.py --embed $bin > $hdr; fi
+    src=$DIR/image_v$v.$way.cpp
+    printf '#define PROGMEM\n#include "CCS811_FW_App_v%s.%s.h"\nconst uint8_t * image(void) { return image_data; }\n' $v $way > $src
+    h=$(wc -c < $hdr)
+    i=$($CXX -E $src | wc -c)
+    best=
+    run=0
+    while [ $run -lt $RUNS ]; do
+      t0=$(now_ms)
+      $CXX -O2 -c -o $DIR/image.o $src || exit 1
+      ms=$(( $(now_ms) - t0 ))
+      if [ -z "$best" ] || [ $ms -lt $best ]; then best=$ms; fi
+      run=$((run+1))
+    done
+    echo "$way,v$v,$h,$i,$best"
+    total_h=$((total_h+h)); total_i=$((total_i+i)); total_ms=$((total_ms+best))
+  done
+  echo "$way,total,$total_h,$total_i,$total_ms"
+done
+rm -rf $DIR
@@ -0,0 +1,287 @@
+/*
+  host.cpp - Host (Linux) stand-in for the Arduino core: virtual clock, GPIO, Stream and Serial.
+  2026 oct 17  v4  Added Stream
+  2026 oct 17  v3  Added interrupts
+  2026 oct 17  v2  Added bus cost accounting
+  2026 oct 17  v1  Created
+*/
+
+
+#include <stdio.h>
+#include "Arduino.h"
+#include "host.h"
+
+
+// Virtual clock ======================================================================================================
+
+
+#define HOST_BUSES_MAX     8
+
+
+static uint64_t     host_now_us;
+static HostI2CBus * host_buses[HOST_BUSES_MAX];
+static int          host_bus_count;
+static HostStats    host_counters;
+
+
+// Current virtual time in us since start.
+uint64_t host_time_us(void) {
+  return host_now_us;
+}
+
+
+// Advance the virtual clock (devices get a tick).
+void host_advance_us(uint64_t us) {
+  host_now_us+= us;
+  for( int i=0; i<host_bus_count; i++ ) host_buses[i]->tick(host_now_us);
+}
+
+
+unsigned long millis(void) {
+  return (unsigned long)(host_now_us/1000);
+}
+
+
+unsigned long micros(void) {
+  return (unsigned long)host_now_us;
+}
+
+
+void delay(unsigned long ms) {
+  host_counters.delay_us+= (uint64_t)ms*1000;
+  host_advance_us((uint64_t)ms*1000);
+}
+
+
+void delayMicroseconds(unsigned int us) {
+  host_counters.delay_us+= us;
+  host_advance_us(us);
+}
+
+
+// GPIO ===============================================================================================================
+
+
+static uint8_t  host_pin_mode[HOST_PIN_COUNT];
+static uint8_t  host_pin_low[HOST_PIN_COUNT];   // Inverted, so that zero-init means HIGH (pull-up)
+static uint64_t host_pin_time[HOST_PIN_COUNT];
+static uint64_t host_pin_lowsum[HOST_PIN_COUNT];
+static void   (*host_pin_isr[HOST_PIN_COUNT])(void);
+static uint8_t  host_pin_isrmode[HOST_PIN_COUNT];
+static bool     host_irq_enabled= true;
+
+
+void pinMode(int pin, int mode) {
+  if( pin<0 || pin>=HOST_PIN_COUNT ) return;
+  host_pin_mode[pin]= mode;
+}
+
+
+void digitalWrite(int pin, int level) {
+  if( pin<0 || pin>=HOST_PIN_COUNT ) return;
+  uint8_t low= level==LOW;
+  if( host_pin_low[pin]==low ) return;
+  if( !low ) host_pin_lowsum[pin]+= host_now_us-host_pin_time[pin];
+  host_pin_low[pin]= low;
+  host_pin_time[pin]= host_now_us;
+}
+
+
+int digitalRead(int pin) {
+  return host_pin_level(pin);
+}
+
+
+// Current level of `pin` (HIGH when never written).
+int host_pin_level(int pin) {
+  if( pin<0 || pin>=HOST_PIN_COUNT ) return HIGH;
+  return host_pin_low[pin] ? LOW : HIGH;
+}
+
+
+// Virtual time of last level change of `pin`.
+uint64_t host_pin_since_us(int pin) {
+  if( pin<0 || pin>=HOST_PIN_COUNT ) return 0;
+  return host_pin_time[pin];
+}
+
+
+// Accumulated time `pin` was low (since start).
+uint64_t host_pin_low_us(int pin) {
+  if( pin<0 || pin>=HOST_PIN_COUNT ) return 0;
+  uint64_t sum= host_pin_lowsum[pin];
+  if( host_pin_low[pin] ) sum+= host_now_us-host_pin_time[pin];
+  return sum;
+}
+
+
+// A device drives `pin` (runs an attached ISR on a matching edge).
+void host_pin_drive(int pin, int level) {
+  if( pin<0 || pin>=HOST_PIN_COUNT ) return;
+  int old= host_pin_level(pin);
+  digitalWrite(pin,level);
+  int now= host_pin_level(pin);
+  if( old==now || host_pin_isr[pin]==0 || !host_irq_enabled ) return;
+  int mode= host_pin_isrmode[pin];
+  if( mode==CHANGE || (mode==FALLING && now==LOW) || (mode==RISING && now==HIGH) ) host_pin_isr[pin]();
+}
+
+
+void attachInterrupt(int irq, void (*isr)(void), int mode) {
+  if( irq<0 || irq>=HOST_PIN_COUNT ) return;
+  host_pin_isr[irq]= isr;
+  host_pin_isrmode[irq]= mode;
+}
+
+
+void detachInterrupt(int irq) {
+  if( irq<0 || irq>=HOST_PIN_COUNT ) return;
+  host_pin_isr[irq]= 0;
+}
+
+
+// Edges that occur while interrupts are disabled are lost (the host has no pending interrupt flags)
+void noInterrupts(void) {
+  host_irq_enabled= false;
+}
+
+
+void interrupts(void) {
+  host_irq_enabled= true;
+}
+
+
+// I2C ================================================================================================================
+
+
+static long host_i2c_hz= 100000;
+
+
+HostI2CBus::HostI2CBus() {
+  _count= 0;
+  if( host_bus_count<HOST_BUSES_MAX ) host_buses[host_bus_count++]= this;
+}
+
+
+// Connects `dev` to this bus.
+void HostI2CBus::attach(HostI2CDevice * dev) {
+  if( _count<HOST_I2C_DEVICES ) _devs[_count++]= dev;
+}
+
+
+// Disconnects `dev` from this bus.
+void HostI2CBus::detach(HostI2CDevice * dev) {
+  for( int i=0; i<_count; i++ ) {
+    if( _devs[i]==dev ) { _devs[i]= _devs[--_count]; return; }
+  }
+}
+
+
+// Returns the device claiming `addr` (or 0).
+HostI2CDevice * HostI2CBus::find(int addr) {
+  for( int i=0; i<_count; i++ ) if( _devs[i]->claims(addr) ) return _devs[i];
+  return 0;
+}
+
+
+// Ticks all devices on this bus.
+void HostI2CBus::tick(uint64_t now_us) {
+  for( int i=0; i<_count; i++ ) _devs[i]->tick(now_us);
+}
+
+
+// Bus clock used to compute transfer time (default 100kHz).
+void host_i2c_set_clock(long hz) {
+  if( hz>0 ) host_i2c_hz= hz;
+}
+
+
+long host_i2c_get_clock(void) {
+  return host_i2c_hz;
+}
+
+
+// Cost accounting ====================================================================================================
+
+
+// The current counters.
+const HostStats * host_stats(void) {
+  return &host_counters;
+}
+
+
+// Clears all counters.
+void host_stats_reset(void) {
+  memset(&host_counters,0,sizeof host_counters);
+}
+
+
+// Accounts a transfer of `bytes` (after a START), and advances the clock with the time to clock them (9 bits per byte,
+// one bit for the START). Used by Wire.
+void host_stats_transfer(int bytes, bool ack) {
+  uint64_t bits= (uint64_t)bytes*9 + 1;
+  uint64_t us= (bits*1000000 + host_i2c_hz - 1) / host_i2c_hz;
+  host_counters.starts+= 1;
+  host_counters.bytes+= bytes;
+  if( !ack ) host_counters.nacks+= 1;
+  host_counters.bus_us+= us;
+  host_advance_us(us);
+}
+
+
+// Stream =============================================================================================================
+
+
+// Time readBytes() waits for a byte (default 1000ms).
+void Stream::setTimeout(unsigned long ms) {
+  _timeout= ms;
+}
+
+
+// Reads up to `len` bytes into `buf`; returns the number read. Waits (virtual time) up to the timeout for each byte.
+size_t Stream::readBytes(uint8_t * buf, size_t len) {
+  size_t n= 0;
+  while( n<len ) {
+    unsigned long start= millis();
+    while( available()==0 && millis()-start<_timeout ) delay(1);
+    int c= read();
+    if( c<0 ) break;
+    buf[n++]= c;
+  }
+  return n;
+}
+
+
+// Serial =============================================================================================================
+
+
+HostSerial Serial;
+static bool host_serial_on= true;
+
+
+// Enables (default) or silences Serial output.
+void host_serial_enable(bool enable) {
+  host_serial_on= enable;
+}
+
+
+static void host_serial_num(unsigned long v, bool neg, int base) {
+  if( !host_serial_on ) return;
+  if( base==HEX ) printf("%lX",v); else printf(neg?"-%lu":"%lu",v);
+}
+
+
+void HostSerial::begin(long baud)                      { (void)baud; }
+void HostSerial::print(const char * s)                 { if( host_serial_on ) fputs(s,stdout); }
+void HostSerial::print(char c)                         { if( host_serial_on ) putchar(c); }
+void HostSerial::print(int v, int base)                { print((long)v,base); }
+void HostSerial::print(unsigned int v, int base)       { print((unsigned long)v,base); }
+void HostSerial::print(long v, int base)               { if( base==HEX || v>=0 ) host_serial_num((unsigned long)v,false,base); else host_serial_num(-(unsigned long)v,true,base); }
+void HostSerial::print(unsigned long v, int base)      { host_serial_num(v,false,base); }
+void HostSerial::println(void)                         { print('\n'); }
+void HostSerial::println(const char * s)               { print(s); println(); }
+void HostSerial::println(char c)                       { print(c); println(); }
+void HostSerial::println(int v, int base)              { print(v,base); println(); }
+void HostSerial::println(unsigned int v, int base)     { print(v,base); println(); }
+void HostSerial::println(long v, int base)             { print(v,base); println(); }
+void HostSerial::println(unsigned long v, int base)    { print(v,base); println(); }
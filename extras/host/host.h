@@ -0,0 +1,84 @@
+/*
+  host.h - Control interface of the host (Linux) Arduino stand-in: virtual clock, GPIO inspection and simulated I2C buses.
+  2026 oct 17  v3  Added host_pin_drive (interrupts)
+  2026 oct 17  v2  Added bus cost accounting (HostStats)
+  2026 oct 17  v1  Created
+*/
+#ifndef _HOST_H_
+#define _HOST_H_
+
+
+#include <stdint.h>
+
+
+// Virtual clock ======================================================================================================
+
+
+uint64_t host_time_us(void);                                                  // Current virtual time in us since start.
+void     host_advance_us(uint64_t us);                                        // Advance the virtual clock (devices get a tick).
+void     host_serial_enable(bool enable);                                     // Enables (default) or silences Serial output.
+
+
+// GPIO ===============================================================================================================
+
+
+#define HOST_PIN_COUNT     64
+
+int      host_pin_level(int pin);                                             // Current level of `pin` (HIGH when never written).
+uint64_t host_pin_since_us(int pin);                                          // Virtual time of last level change of `pin`.
+uint64_t host_pin_low_us(int pin);                                            // Accumulated time `pin` was low (since start).
+void     host_pin_drive(int pin, int level);                                  // A device drives `pin` (runs an attached ISR on a matching edge).
+
+
+// I2C ================================================================================================================
+
+
+// A simulated I2C slave. A bus calls write() for a master write and read() for a master read.
+class HostI2CDevice {
+  public:
+    virtual ~HostI2CDevice() {}
+    virtual bool claims(int addr) = 0;                                        // Does this device ACK slave address `addr`?
+    virtual bool write(int addr, const uint8_t * buf, int count) = 0;         // Master writes `count` bytes. Returns false for NACK.
+    virtual bool read(int addr, uint8_t * buf, int count) = 0;                // Master reads `count` bytes. Returns false for NACK.
+    virtual void tick(uint64_t now_us) { (void)now_us; }                      // Called whenever the virtual clock advances.
+};
+
+
+// A simulated I2C bus with up to HOST_I2C_DEVICES slaves.
+#define HOST_I2C_DEVICES   16
+
+class HostI2CBus {
+  public:
+    HostI2CBus();
+    void attach(HostI2CDevice * dev);                                         // Connects `dev` to this bus.
+    void detach(HostI2CDevice * dev);                                         // Disconnects `dev` from this bus.
+    HostI2CDevice * find(int addr);                                           // Returns the device claiming `addr` (or 0).
+    void tick(uint64_t now_us);                                               // Ticks all devices on this bus.
+  private:
+    HostI2CDevice * _devs[HOST_I2C_DEVICES];
+    int _count;
+};
+
+
+void     host_i2c_set_clock(long hz);                                         // Bus clock used to compute transfer time (default 100kHz).
+long     host_i2c_get_clock(void);
+
+
+// Cost accounting ====================================================================================================
+
+
+// Costs accumulated since the last host_stats_reset(), over all buses.
+struct HostStats {
+  uint32_t starts;                                                            // START and repeated START conditions
+  uint32_t bytes;                                                             // Bytes on the wire, including slave address bytes
+  uint32_t nacks;                                                             // Transfers not acknowledged
+  uint64_t bus_us;                                                            // Time spent clocking bytes on the bus
+  uint64_t delay_us;                                                          // Time spent in delay() and delayMicroseconds()
+};
+
+const HostStats * host_stats(void);                                           // The current counters.
+void     host_stats_reset(void);                                              // Clears all counters.
+void     host_stats_transfer(int bytes, bool ack);                            // Accounts a transfer of `bytes` (after a START) - used by Wire.
+
+
+#endif
@@ -0,0 +1,48 @@
+/*
+  linuxbussim.cpp - Userspace stand-in for /dev/i2c-N: a CCS811LinuxBus whose I2C_RDWR messages go to a simulated I2C bus.
+  So the Linux transport can be run (and benchmarked) against the simulated CCS811, without kernel or hardware.
+  2026 oct 17  v2  Added transfers and messages
+  2026 oct 17  v1  Created
+*/
+
+
+#include <linux/i2c.h>
+#include "linuxbussim.h"
+
+
+// The simulated bus the messages go to (no begin() needed).
+CCS811LinuxBusSim::CCS811LinuxBusSim(HostI2CBus * bus) : CCS811LinuxBus("sim") {
+  _bus= bus;
+  _transfers= 0;
+  _messages= 0;
+}
+
+
+// Number of I2C_RDWR ioctls (since construction).
+uint32_t CCS811LinuxBusSim::transfers(void) {
+  return _transfers;
+}
+
+
+// Number of messages in those ioctls.
+uint32_t CCS811LinuxBusSim::messages(void) {
+  return _messages;
+}
+
+
+// As the kernel: a (repeated) START per message, stops at the first NACK.
+bool CCS811LinuxBusSim::transfer(struct i2c_msg * msgs, int count) {
+  _transfers++;
+  _messages+= count;
+  for( int i=0; i<count; i++ ) {
+    HostI2CDevice * dev= _bus->find(msgs[i].addr);
+    bool ack= false;
+    if( dev!=0 ) {
+      if( msgs[i].flags & I2C_M_RD ) ack= dev->read(msgs[i].addr,msgs[i].buf,msgs[i].len);
+      else ack= dev->write(msgs[i].addr,msgs[i].buf,msgs[i].len);
+    }
+    host_stats_transfer(ack?1+msgs[i].len:1,ack);
+    if( !ack ) return false;
+  }
+  return true;
+}
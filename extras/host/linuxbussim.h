@@ -0,0 +1,29 @@
+/*
+  linuxbussim.h - Userspace stand-in for /dev/i2c-N: a CCS811LinuxBus whose I2C_RDWR messages go to a simulated I2C bus.
+  So the Linux transport can be run (and benchmarked) against the simulated CCS811, without kernel or hardware.
+  2026 oct 17  v2  Added transfers and messages
+  2026 oct 17  v1  Created
+*/
+#ifndef _LINUXBUSSIM_H_
+#define _LINUXBUSSIM_H_
+
+
+#include "host.h"
+#include "ccs811linuxbus.h"
+
+
+class CCS811LinuxBusSim : public CCS811LinuxBus {
+  public:
+    CCS811LinuxBusSim(HostI2CBus * bus);                                      // The simulated bus the messages go to (no begin() needed).
+    uint32_t transfers(void);                                                 // Number of I2C_RDWR ioctls (since construction).
+    uint32_t messages(void);                                                  // Number of messages in those ioctls.
+  protected:
+    virtual bool transfer(struct i2c_msg * msgs, int count);                  // As the kernel: a (repeated) START per message, stops at the first NACK.
+  private:
+    HostI2CBus * _bus;
+    uint32_t     _transfers;
+    uint32_t     _messages;
+};
+
+
+#endif
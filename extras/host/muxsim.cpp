@@ -0,0 +1,73 @@
+/*
+  muxsim.cpp - Simulator of a TCA9548A I2C multiplexer, to be attached to a simulated I2C bus (see host.h).
+  Devices behind it are reachable when their channel is enabled in the (single byte) control register.
+  2026 oct 17  v1  Created
+*/
+
+
+#include "muxsim.h"
+
+
+// Slave address (0x70..0x77); all channels disabled.
+TCA9548ASim::TCA9548ASim(int slaveaddr) {
+  _slaveaddr= slaveaddr;
+  _control= 0;
+  _writes= 0;
+  for( int c=0; c<MUXSIM_CHANNELS; c++ ) _count[c]= 0;
+}
+
+
+// Connects `dev` to `channel`.
+void TCA9548ASim::attach(int channel, HostI2CDevice * dev) {
+  if( channel<0 || channel>=MUXSIM_CHANNELS || _count[channel]>=MUXSIM_DEVICES ) return;
+  _devs[channel][_count[channel]++]= dev;
+}
+
+
+// Current control register (bit n: channel n enabled).
+uint8_t TCA9548ASim::control(void) {
+  return _control;
+}
+
+
+// Number of control register writes.
+uint32_t TCA9548ASim::writes(void) {
+  return _writes;
+}
+
+
+// The device on an enabled channel claiming `addr` (or 0).
+HostI2CDevice * TCA9548ASim::find(int addr) {
+  for( int c=0; c<MUXSIM_CHANNELS; c++ ) {
+    if( (_control & (1<<c))==0 ) continue;
+    for( int i=0; i<_count[c]; i++ ) if( _devs[c][i]->claims(addr) ) return _devs[c][i];
+  }
+  return 0;
+}
+
+
+bool TCA9548ASim::claims(int addr) {
+  return addr==_slaveaddr || find(addr)!=0;
+}
+
+
+// A write to the mux itself sets the control register (the last byte counts)
+bool TCA9548ASim::write(int addr, const uint8_t * buf, int count) {
+  if( addr!=_slaveaddr ) { HostI2CDevice * dev= find(addr); return dev!=0 && dev->write(addr,buf,count); }
+  if( count>0 ) { _control= buf[count-1]; _writes++; }
+  return true;
+}
+
+
+// A read from the mux itself returns the control register
+bool TCA9548ASim::read(int addr, uint8_t * buf, int count) {
+  if( addr!=_slaveaddr ) { HostI2CDevice * dev= find(addr); return dev!=0 && dev->read(addr,buf,count); }
+  for( int i=0; i<count; i++ ) buf[i]= _control;
+  return true;
+}
+
+
+// Devices behind the mux keep running, also when their channel is disabled
+void TCA9548ASim::tick(uint64_t now_us) {
+  for( int c=0; c<MUXSIM_CHANNELS; c++ ) for( int i=0; i<_count[c]; i++ ) _devs[c][i]->tick(now_us);
+}
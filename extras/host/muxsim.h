@@ -0,0 +1,41 @@
+/*
+  muxsim.h - Simulator of a TCA9548A I2C multiplexer, to be attached to a simulated I2C bus (see host.h).
+  Devices behind it are reachable when their channel is enabled in the (single byte) control register.
+  2026 oct 17  v1  Created
+*/
+#ifndef _MUXSIM_H_
+#define _MUXSIM_H_
+
+
+#include <stdint.h>
+#include "host.h"
+
+
+#define MUXSIM_CHANNELS    8 // Channels of a TCA9548A
+#define MUXSIM_DEVICES     4 // Devices per channel
+
+
+class TCA9548ASim : public HostI2CDevice {
+  public: // Construction and configuration
+    TCA9548ASim(int slaveaddr=0x70);                                          // Slave address (0x70..0x77); all channels disabled.
+    void attach(int channel, HostI2CDevice * dev);                            // Connects `dev` to `channel`.
+  public: // Inspection
+    uint8_t  control(void);                                                   // Current control register (bit n: channel n enabled).
+    uint32_t writes(void);                                                    // Number of control register writes.
+  public: // HostI2CDevice
+    virtual bool claims(int addr);
+    virtual bool write(int addr, const uint8_t * buf, int count);
+    virtual bool read(int addr, uint8_t * buf, int count);
+    virtual void tick(uint64_t now_us);
+  private:
+    HostI2CDevice * find(int addr);                                           // The device on an enabled channel claiming `addr` (or 0).
+  private:
+    int      _slaveaddr;
+    uint8_t  _control;
+    uint32_t _writes;
+    HostI2CDevice * _devs[MUXSIM_CHANNELS][MUXSIM_DEVICES];
+    int      _count[MUXSIM_CHANNELS];
+};
+
+
+#endif
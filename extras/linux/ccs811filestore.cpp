@@ -0,0 +1,52 @@
+/*
+  ccs811filestore.cpp - Store for the baseline manager (CCS811Baseline) in a file, e.g. on a Linux gateway (or the host build).
+  A missing file reads as erased (0xFF); writes create it.
+  2026 oct 17  v1  Created
+*/
+
+
+#include <stdio.h>
+#include <string.h>
+#include "ccs811filestore.h"
+
+
+// The file, and the number of bytes to use (the file is not opened here).
+CCS811FileStore::CCS811FileStore(const char * path, int size) {
+  _path= path;
+  _size= size;
+}
+
+
+// Number of bytes in the store.
+int CCS811FileStore::size(void) {
+  return _size;
+}
+
+
+// Reads `count` bytes at `addr` into `buf`. Bytes beyond the end of the file (or of a missing file) read as 0xFF.
+bool CCS811FileStore::read(int addr, uint8_t * buf, int count) {
+  if( addr<0 || addr+count>_size ) return false;
+  memset(buf,0xFF,count);
+  FILE * f= fopen(_path,"rb");
+  if( f==0 ) return true;
+  if( fseek(f,addr,SEEK_SET)==0 ) { size_t n= fread(buf,1,count,f); (void)n; } // A short read leaves 0xFF
+  fclose(f);
+  return true;
+}
+
+
+// Writes `count` bytes from `buf` at `addr`. Creates the file (0xFF filled up to `addr`) when needed, and flushes.
+bool CCS811FileStore::write(int addr, const uint8_t * buf, int count) {
+  if( addr<0 || addr+count>_size ) return false;
+  FILE * f= fopen(_path,"r+b");
+  if( f==0 ) f= fopen(_path,"w+b");
+  if( f==0 ) { perror(_path); return false; }
+  bool ok= fseek(f,0,SEEK_END)==0;
+  long end= ftell(f);
+  while( ok && end<addr ) { ok= fputc(0xFF,f)!=EOF; end++; }
+  ok= ok && fseek(f,addr,SEEK_SET)==0;
+  ok= ok && fwrite(buf,1,count,f)==(size_t)count;
+  ok= fflush(f)==0 && ok;
+  fclose(f);
+  return ok;
+}
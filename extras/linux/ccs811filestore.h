@@ -0,0 +1,27 @@
+/*
+  ccs811filestore.h - Store for the baseline manager (CCS811Baseline) in a file, e.g. on a Linux gateway (or the host build).
+  A missing file reads as erased (0xFF); writes create it.
+  2026 oct 17  v1  Created
+*/
+#ifndef _CCS811FILESTORE_H_
+#define _CCS811FILESTORE_H_
+
+
+#include <stdint.h>
+#include "ccs811baseline.h"
+
+
+class CCS811FileStore : public CCS811Store {
+  public:
+    CCS811FileStore(const char * path, int size);                             // The file, and the number of bytes to use (the file is not opened here).
+  public: // CCS811Store
+    virtual int  size(void);
+    virtual bool read(int addr, uint8_t * buf, int count);                    // Bytes beyond the end of the file (or of a missing file) read as 0xFF.
+    virtual bool write(int addr, const uint8_t * buf, int count);             // Creates the file (0xFF filled up to `addr`) when needed, and flushes.
+  private:
+    const char * _path;
+    int          _size;
+};
+
+
+#endif
@@ -0,0 +1,39 @@
+/*
+  ccs811linux.cpp - Reads a CCS811 on a Linux gateway via /dev/i2c-N, with the real-time Arduino shim (see shim/Arduino.h).
+  SYNTAX: ccs811linux [<device> [<slaveaddr>]], e.g. ccs811linux /dev/i2c-1 0x5A. nWAKE must be tied to GND.
+  2026 oct 17  v1  Created
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "Arduino.h"
+#include "ccs811.h"
+#include "ccs811linuxbus.h"
+
+
+int main(int argc, char * argv[]) {
+  const char * device= argc>1 ? argv[1] : "/dev/i2c-1";
+  int slaveaddr= argc>2 ? (int)strtol(argv[2],0,0) : CCS811_SLAVEADDR_0;
+  if( argc>3 ) { fprintf(stderr,"SYNTAX: ccs811linux [<device> [<slaveaddr>]]\n"); return 2; }
+
+  CCS811LinuxBus bus(device);
+  if( !bus.begin() ) return 1;
+  CCS811 ccs811(-1, slaveaddr, -1, &bus); // nWAKE and nINT not connected
+
+  // Enable and start CCS811 (measure every 1 second)
+  if( !ccs811.begin() ) { fprintf(stderr,"ccs811linux: begin failed\n"); return 1; }
+  printf("ccs811linux: hardware %X, bootloader %X, application %X\n", ccs811.hardware_version(), ccs811.bootloader_version(), ccs811.application_version());
+  if( !ccs811.start(CCS811_MODE_1SEC) ) { fprintf(stderr,"ccs811linux: start failed\n"); return 1; }
+
+  while( true ) {
+    delay(1000);
+    uint16_t eco2, etvoc, errstat, raw;
+    ccs811.read(&eco2,&etvoc,&errstat,&raw);
+    if( errstat==CCS811_ERRSTAT_OK ) printf("ccs811linux: eco2=%u ppm  etvoc=%u ppb\n",eco2,etvoc);
+    else if( errstat==CCS811_ERRSTAT_OK_NODATA ) printf("ccs811linux: waiting for (new) data\n");
+    else if( errstat & CCS811_ERRSTAT_I2CFAIL ) printf("ccs811linux: I2C error\n");
+    else printf("ccs811linux: errstat=%X=%s\n",errstat,ccs811.errstat_str(errstat));
+    fflush(stdout);
+  }
+}
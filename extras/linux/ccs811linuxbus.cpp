@@ -0,0 +1,90 @@
+/*
+  ccs811linuxbus.cpp - I2C transport for the CCS811 driver on Linux, via /dev/i2c-N (i2c-dev).
+  A register read is a single I2C_RDWR ioctl with a write and a read message, so the kernel issues a true repeated START.
+  2026 oct 17  v1  Created
+*/
+
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include "ccs811linuxbus.h"
+
+
+// E.g. "/dev/i2c-1"; the device is opened by begin().
+CCS811LinuxBus::CCS811LinuxBus(const char * device) {
+  _device= device;
+  _fd= -1;
+}
+
+
+// Closes the device (if open).
+CCS811LinuxBus::~CCS811LinuxBus() {
+  if( _fd>=0 ) close(_fd);
+}
+
+
+// Opens the device. Returns false (and prints why to stderr) on failure.
+bool CCS811LinuxBus::begin(void) {
+  if( _fd>=0 ) return true;
+  _fd= open(_device,O_RDWR);
+  if( _fd<0 ) { fprintf(stderr,"ccs811linuxbus: can not open '%s' (%s)\n",_device,strerror(errno)); return false; }
+  unsigned long funcs;
+  if( ioctl(_fd,I2C_FUNCS,&funcs)<0 || (funcs&I2C_FUNC_I2C)==0 ) {
+    fprintf(stderr,"ccs811linuxbus: '%s' does not support I2C_RDWR\n",_device);
+    close(_fd);
+    _fd= -1;
+    return false;
+  }
+  return true;
+}
+
+
+// CCS811Bus ==========================================================================================================
+
+
+bool CCS811LinuxBus::write(int slaveaddr, int regaddr, int count, const uint8_t * buf) {
+  if( count>CCS811LINUXBUS_MAXWRITE ) return false;
+  uint8_t wbuf[1+CCS811LINUXBUS_MAXWRITE];
+  wbuf[0]= regaddr;
+  if( count>0 ) memcpy(wbuf+1,buf,count);
+  struct i2c_msg msg= { (uint16_t)slaveaddr, 0, (uint16_t)(1+count), wbuf };
+  return transfer(&msg,1);
+}
+
+
+// A plain register write (with STOP); the CCS811 keeps the mailbox for the next read.
+bool CCS811LinuxBus::select(int slaveaddr, int regaddr) {
+  return write(slaveaddr,regaddr,0,0);
+}
+
+
+bool CCS811LinuxBus::fetch(int slaveaddr, int count, uint8_t * buf) {
+  struct i2c_msg msg= { (uint16_t)slaveaddr, I2C_M_RD, (uint16_t)count, buf };
+  return transfer(&msg,1);
+}
+
+
+// One ioctl, write plus read message; `delay_us` is ignored (the kernel handles clock stretching).
+bool CCS811LinuxBus::read(int slaveaddr, int regaddr, int count, uint8_t * buf, int delay_us) {
+  (void)delay_us;
+  uint8_t reg= regaddr;
+  struct i2c_msg msgs[2]= {
+    { (uint16_t)slaveaddr, 0,        1,               &reg },  // START, SLAVEADDR, register address
+    { (uint16_t)slaveaddr, I2C_M_RD, (uint16_t)count, buf  },  // Repeated START, SLAVEADDR, read bytes, STOP
+  };
+  return transfer(msgs,2);
+}
+
+
+// Performs `count` messages as one I2C_RDWR (one STOP). Returns false on I2C problems.
+bool CCS811LinuxBus::transfer(struct i2c_msg * msgs, int count) {
+  if( _fd<0 ) return false;
+  struct i2c_rdwr_ioctl_data data= { msgs, (uint32_t)count };
+  return ioctl(_fd,I2C_RDWR,&data)==count;
+}
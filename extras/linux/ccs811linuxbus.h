@@ -0,0 +1,39 @@
+/*
+  ccs811linuxbus.h - I2C transport for the CCS811 driver on Linux, via /dev/i2c-N (i2c-dev).
+  A register read is a single I2C_RDWR ioctl with a write and a read message, so the kernel issues a true repeated START.
+  2026 oct 17  v1  Created
+*/
+#ifndef _CCS811LINUXBUS_H_
+#define _CCS811LINUXBUS_H_
+
+
+#include <stdint.h>
+#include "ccs811.h"
+
+
+struct i2c_msg;
+
+
+// Largest register write (register address not included); the CCS811 needs at most 8 (APP_DATA)
+#define CCS811LINUXBUS_MAXWRITE  32
+
+
+class CCS811LinuxBus : public CCS811Bus {
+  public:
+    CCS811LinuxBus(const char * device);                                      // E.g. "/dev/i2c-1"; the device is opened by begin().
+    virtual ~CCS811LinuxBus();                                                // Closes the device (if open).
+    bool begin(void);                                                         // Opens the device. Returns false (and prints why to stderr) on failure.
+  public: // CCS811Bus
+    virtual bool write(int slaveaddr, int regaddr, int count, const uint8_t * buf);
+    virtual bool select(int slaveaddr, int regaddr);                          // A plain register write (with STOP); the CCS811 keeps the mailbox for the next read.
+    virtual bool fetch(int slaveaddr, int count, uint8_t * buf);
+    virtual bool read(int slaveaddr, int regaddr, int count, uint8_t * buf, int delay_us); // One ioctl, write plus read message; `delay_us` is ignored (the kernel handles clock stretching).
+  protected:
+    virtual bool transfer(struct i2c_msg * msgs, int count);                  // Performs `count` messages as one I2C_RDWR (one STOP). Returns false on I2C problems.
+  private:
+    const char * _device;
+    int          _fd;
+};
+
+
+#endif
@@ -0,0 +1,99 @@
+/*
+  Arduino.h - Minimal real-time Arduino API for running the CCS811 driver on a Linux gateway (build with CCS811_NO_WIRE).
+  Time is the monotonic clock of the kernel; there is no GPIO (connect nWAKE to GND and pass -1 for nWAKE and nINT).
+  2026 oct 17  v1  Created
+*/
+#ifndef _LINUX_ARDUINO_H_
+#define _LINUX_ARDUINO_H_
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+typedef uint8_t byte;
+
+
+// Pin levels and modes
+#define LOW                0
+#define HIGH               1
+#define INPUT              0
+#define OUTPUT             1
+#define INPUT_PULLUP       2
+
+
+// Number bases for Serial.print
+#define DEC               10
+#define HEX               16
+
+
+// There is no separate program memory on Linux
+#define PROGMEM
+#define F(s)               (s)
+#define memcpy_P(d,s,n)    memcpy((d),(s),(n))
+#define pgm_read_byte(p)   (*(const uint8_t*)(p))
+
+
+// Interrupt modes
+#define CHANGE             1
+#define FALLING            2
+#define RISING             3
+
+
+// GPIO (none: writes are ignored, reads are HIGH)
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int level);
+int  digitalRead(int pin);
+
+
+// Interrupts (none: an ISR is never called)
+#define digitalPinToInterrupt(pin)  (pin)
+void attachInterrupt(int irq, void (*isr)(void), int mode);
+void detachInterrupt(int irq);
+void noInterrupts(void);
+void interrupts(void);
+
+
+// Time (monotonic clock; delays sleep)
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+
+// Stream (input side only): a source of bytes, e.g. a firmware file
+class Stream {
+  public:
+    virtual ~Stream() {}
+    virtual int available(void) = 0;                                          // Number of bytes that can be read.
+    virtual int read(void) = 0;                                               // Next byte, or -1 when there is none.
+    void setTimeout(unsigned long ms);                                        // Time readBytes() waits for a byte (default 1000ms).
+    size_t readBytes(uint8_t * buf, size_t len);                              // Reads up to `len` bytes into `buf`; returns the number read (less on timeout).
+  protected:
+    unsigned long _timeout= 1000;
+};
+
+
+// Serial (prints to stdout; the driver prints its diagnostics here)
+class LinuxSerial {
+  public:
+    void begin(long baud);
+    void print(const char * s);
+    void print(char c);
+    void print(int v, int base=DEC);
+    void print(unsigned int v, int base=DEC);
+    void print(long v, int base=DEC);
+    void print(unsigned long v, int base=DEC);
+    void println(void);
+    void println(const char * s);
+    void println(char c);
+    void println(int v, int base=DEC);
+    void println(unsigned int v, int base=DEC);
+    void println(long v, int base=DEC);
+    void println(unsigned long v, int base=DEC);
+};
+extern LinuxSerial Serial;
+
+
+#endif
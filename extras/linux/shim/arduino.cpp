@@ -0,0 +1,103 @@
+/*
+  arduino.cpp - Minimal real-time Arduino API for running the CCS811 driver on a Linux gateway (build with CCS811_NO_WIRE).
+  2026 oct 17  v1  Created
+*/
+
+
+#include <stdio.h>
+#include <time.h>
+#include "Arduino.h"
+
+
+// Time ===============================================================================================================
+
+
+static uint64_t linux_now_us(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC,&ts);
+  return (uint64_t)ts.tv_sec*1000000 + ts.tv_nsec/1000;
+}
+
+
+static void linux_sleep_us(uint64_t us) {
+  struct timespec ts= { (time_t)(us/1000000), (long)(us%1000000)*1000 };
+  while( nanosleep(&ts,&ts)!=0 ) ; // Resume after a signal
+}
+
+
+unsigned long millis(void) {
+  return (unsigned long)(linux_now_us()/1000);
+}
+
+
+unsigned long micros(void) {
+  return (unsigned long)linux_now_us();
+}
+
+
+void delay(unsigned long ms) {
+  linux_sleep_us((uint64_t)ms*1000);
+}
+
+
+// Sleeps at least `us`. The driver only waits between I2C transfers, so oversleeping (timer slack) is harmless.
+void delayMicroseconds(unsigned int us) {
+  linux_sleep_us(us);
+}
+
+
+// GPIO and interrupts ================================================================================================
+
+
+void pinMode(int pin, int mode)                               { (void)pin; (void)mode; }
+void digitalWrite(int pin, int level)                         { (void)pin; (void)level; }
+int  digitalRead(int pin)                                     { (void)pin; return HIGH; }
+void attachInterrupt(int irq, void (*isr)(void), int mode)    { (void)irq; (void)isr; (void)mode; }
+void detachInterrupt(int irq)                                 { (void)irq; }
+void noInterrupts(void)                                       { }
+void interrupts(void)                                         { }
+
+
+// Stream =============================================================================================================
+
+
+// Time readBytes() waits for a byte (default 1000ms).
+void Stream::setTimeout(unsigned long ms) {
+  _timeout= ms;
+}
+
+
+// Reads up to `len` bytes into `buf`; returns the number read. Waits up to the timeout for each byte.
+size_t Stream::readBytes(uint8_t * buf, size_t len) {
+  size_t n= 0;
+  while( n<len ) {
+    unsigned long start= millis();
+    while( available()==0 && millis()-start<_timeout ) delay(1);
+    int c= read();
+    if( c<0 ) break;
+    buf[n++]= c;
+  }
+  return n;
+}
+
+
+// Serial =============================================================================================================
+
+
+LinuxSerial Serial;
+
+
+void LinuxSerial::begin(long baud)                      { (void)baud; }
+void LinuxSerial::print(const char * s)                 { fputs(s,stdout); }
+void LinuxSerial::print(char c)                         { putchar(c); }
+void LinuxSerial::print(int v, int base)                { print((long)v,base); }
+void LinuxSerial::print(unsigned int v, int base)       { print((unsigned long)v,base); }
+void LinuxSerial::print(long v, int base)               { if( base==HEX ) printf("%lX",(unsigned long)v); else printf("%ld",v); }
+void LinuxSerial::print(unsigned long v, int base)      { printf(base==HEX?"%lX":"%lu",v); }
+void LinuxSerial::println(void)                         { print('\n'); fflush(stdout); }
+void LinuxSerial::println(const char * s)               { print(s); println(); }
+void LinuxSerial::println(char c)                       { print(c); println(); }
+void LinuxSerial::println(int v, int base)              { print(v,base); println(); }
+void LinuxSerial::println(unsigned int v, int base)     { print(v,base); println(); }
+void LinuxSerial::println(long v, int base)             { print(v,base); println(); }
+void LinuxSerial::println(unsigned long v, int base)    { print(v,base); println(); }
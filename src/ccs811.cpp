@@ -1,5 +1,44 @@
 /*
   ccs811.cpp - Library for the CCS811 digital gas sensor for monitoring indoor air quality from ams.
+  2026 oct 17  v50  The cached mailbox is dropped when nWAKE goes high
+  2026 oct 17  v49  CCS811Baseline retries a failed save (I2C or store) after CCS811BASELINE_RETRY_MS
+  2026 oct 17  v48  CCS811Manager: static_assert that the set_envdata() bit mask fits CCS811MANAGER_MAX
+  2026 oct 17  v47  CCS811Manager: static_assert that the flash() bit mask fits CCS811MANAGER_MAX
+  2026 oct 17  v46  CCS811Manager::poll() returns raw 0 when read_raw fails
+  2026 oct 17  v45  read_raw() returns 0 on I2C problems (as read())
+  2026 oct 17  v44  Adaptive flash polls STATUS before APP_DATA and APP_VERIFY instead of resending them
+  2026 oct 17  v43  read_begin() clears the result buffer, so a no-data read_poll() returns 0s as read()
+  2026 oct 17  v42  set_envdata_deadband: maxage_ms 0 means no maximum age
+  2026 oct 17  v42  Adaptive flash polls STATUS before APP_DATA and APP_VERIFY instead of resending them
+  2026 oct 17  v41  CCS811Baseline: begin(restore=false) after a warm resume; save() retries a failed read
+  2026 oct 17  v40  begin_warm() cold-starts an idle CCS811 and rewrites interrupt flags that differ from start()
+  2026 oct 17  v39  flash_image() skips only when STATUS has APP_VALID and no ERROR
+  2026 oct 17  v38  Blocking flash shares one wait loop (flash_run); read_begin refuses during a flash
+  2026 oct 17  v37  CCS811MuxBus::fetch after a select no longer switches the channel
+  2026 oct 17  v36  Added CCS811_NO_WIRE (no default Wire transport, e.g. for Linux)
+  2026 oct 17  v35  Include Arduino.h and Wire.h instead of forward declaring Stream and TwoWire
+  2026 oct 17  v34  Fixed the mailbox cache after a failed select (i2cwrite)
+  2026 oct 17  v33  Added ENV_DATA fan-out (CCS811Manager::set_envdata)
+  2026 oct 17  v32  Added change-suppressed ENV_DATA writes (set_envdata_deadband)
+  2026 oct 17  v31  Added integer (constexpr) ENV_DATA conversions and set_envdata_mCelsius_mpercRH
+  2026 oct 17  v30  Added baseline persistence (CCS811Baseline in ccs811baseline.h)
+  2026 oct 17  v29  Added warm start (begin_warm: resume a running CCS811 without reset)
+  2026 oct 17  v28  Added packed firmware images (CCS811Unpack in ccs811unpack.h)
+  2026 oct 17  v27  Added firmware image container (flash_image: validate, skip when installed)
+  2026 oct 17  v26  Flash from a reader callback or Stream (no image in PROGMEM)
+  2026 oct 17  v25  Parallel flash of several sensors (CCS811Manager::flash)
+  2026 oct 17  v24  Added adaptive timing (poll until ready instead of fixed waits in begin and flash)
+  2026 oct 17  v23  Added non-blocking flash (flash_begin/flash_poll), flash() now runs it blocking
+  2026 oct 17  v22  Added get_bus
+  2026 oct 17  v21  Added get_mode, start() records the mode
+  2026 oct 17  v20  I2C goes via a CCS811Bus (default CCS811WireBus on Wire)
+  2026 oct 17  v19  read() only transfers the ALG_RESULT_DATA bytes of the non-NULL args
+  2026 oct 17  v18  i2cread skips the select of an already selected mailbox, read() clears ERROR_ID in its own wake window
+  2026 oct 17  v17  Added wake sessions (wake_begin/wake_end), wake_up/wake_down nest
+  2026 oct 17  v16  Added CCS811_MODE_250MS and read_raw
+  2026 oct 17  v15  Added threshold interrupts (set_thresholds)
+  2026 oct 17  v14  Added nINT support (data_ready)
+  2026 oct 17  v13  Added non-blocking read (read_begin/read_poll)
   2021 jul 18  v12  Maarten Pennings  Added set_envdata_Celsius_percRH
   2021 jul 10  v11  Maarten Pennings  API comments improved
   2019 jan 22  v10  Maarten Pennings  Added F() on all strings, added get/set_baseline()
@@ -16,7 +55,9 @@
 
 
 #include <Arduino.h>
+#ifndef CCS811_NO_WIRE
 #include <Wire.h>
+#endif
 #include "ccs811.h"
 
 
@@ -41,6 +82,14 @@
 #define CCS811_WAIT_AFTER_APPDATA_MS     50 // The CCS811 needs a wait after writing app data
 
 
+// With adaptive timing (set_adaptive_timing), the waits above are replaced by polling the CCS811: the first poll 
+// is after 1/CCS811_ADAPTIVE_FIRST_DIV of the wait, the next ones every 1/CCS811_ADAPTIVE_POLL_DIV of the wait, 
+// and polling gives up after CCS811_ADAPTIVE_TIMEOUT_MUL times the wait
+#define CCS811_ADAPTIVE_FIRST_DIV         4
+#define CCS811_ADAPTIVE_POLL_DIV         16
+#define CCS811_ADAPTIVE_TIMEOUT_MUL       2
+
+
 // Main interface =====================================================================================================
 
 
@@ -64,15 +113,98 @@
 #define CCS811_SW_RESET         0xFF // 4 bytes
 
 
-// Pin number connected to nWAKE (nWAKE can also be bound to GND, then pass -1), slave address (5A or 5B)
-CCS811::CCS811(int nwake, int slaveaddr) {
+// Flags in MEAS_MODE (next to the drive mode in bits 6..4)
+#define CCS811_MEAS_MODE_INT_DATARDY  0x08 // nINT asserted when a new sample is ready
+#define CCS811_MEAS_MODE_INT_THRESH   0x04 // ... but only when eCO2 crossed a threshold (requires INT_DATARDY)
+#define CCS811_MEAS_MODE_RESERVED     0x83 // Reserved bits, must be 0
+
+
+// The states of the non-blocking read
+#define CCS811_RDSTATE_IDLE     0 // No read in progress
+#define CCS811_RDSTATE_WAKE     1 // nWAKE is low, waiting CCS811_WAIT_AFTER_WAKE_US
+#define CCS811_RDSTATE_STATUS   2 // STATUS is selected (pre 2.0.0 firmware), waiting _i2cdelay_us for the repeated START
+#define CCS811_RDSTATE_RESULT   3 // ALG_RESULT_DATA is selected, waiting _i2cdelay_us for the repeated START
+#define CCS811_RDSTATE_ERRORID  4 // ERROR_ID is selected (to clear it), waiting _i2cdelay_us for the repeated START
+
+
+// The states of the non-blocking flash (each state is one I2C transaction, done after the wait set by the previous state)
+#define CCS811_FLSTATE_IDLE          0 // No flash in progress
+#define CCS811_FLSTATE_PING          1 // Ping (after waiting CCS811_WAIT_AFTER_WAKE_US)
+#define CCS811_FLSTATE_RESET1        2 // SW_RESET
+#define CCS811_FLSTATE_STATUS1       3 // Check STATUS after reset (after CCS811_WAIT_AFTER_RESET_US)
+#define CCS811_FLSTATE_ERASE         4 // APP_ERASE
+#define CCS811_FLSTATE_STATUSERASE   5 // Check STATUS after erase (after CCS811_WAIT_AFTER_APPERASE_MS)
+#define CCS811_FLSTATE_DATA          6 // Write a block to APP_DATA (after CCS811_WAIT_AFTER_APPDATA_MS for the previous one)
+#define CCS811_FLSTATE_VERIFY        7 // APP_VERIFY
+#define CCS811_FLSTATE_STATUSVERIFY  8 // Check STATUS after verify (after CCS811_WAIT_AFTER_APPVERIFY_MS)
+#define CCS811_FLSTATE_RESET2        9 // Second SW_RESET
+#define CCS811_FLSTATE_STATUS2      10 // Check STATUS after second reset (after CCS811_WAIT_AFTER_RESET_US)
+
+
+// ISRs can not be methods, so there is a fixed number of ISRs (slots); each sets its own bit in ccs811_int_pending.
+#define CCS811_INT_SLOTS  4
+
+#if defined(IRAM_ATTR)
+  #define CCS811_ISR_ATTR IRAM_ATTR // ESP8266 and ESP32 need ISRs in RAM
+#else
+  #define CCS811_ISR_ATTR
+#endif
+
+static volatile uint8_t ccs811_int_pending; // Bit `slot` set by ISR of `slot`: new sample signalled
+static uint8_t ccs811_int_used;             // Bit `slot` set when `slot` is assigned to an instance
+
+static void CCS811_ISR_ATTR ccs811_isr0(void) { ccs811_int_pending|= 0x01; }
+static void CCS811_ISR_ATTR ccs811_isr1(void) { ccs811_int_pending|= 0x02; }
+static void CCS811_ISR_ATTR ccs811_isr2(void) { ccs811_int_pending|= 0x04; }
+static void CCS811_ISR_ATTR ccs811_isr3(void) { ccs811_int_pending|= 0x08; }
+static void (* const ccs811_isrs[CCS811_INT_SLOTS])(void)= { ccs811_isr0, ccs811_isr1, ccs811_isr2, ccs811_isr3 };
+
+
+#ifndef CCS811_NO_WIRE
+// The transport used when the constructor gets none
+static CCS811WireBus ccs811_wirebus(Wire);
+#endif
+
+
+// Pin number connected to nWAKE (nWAKE can also be bound to GND, then pass -1), slave address (5A or 5B), pin number connected to nINT (or -1), transport (0 for Wire, required with CCS811_NO_WIRE)
+CCS811::CCS811(int nwake, int slaveaddr, int nint, CCS811Bus * bus) {
   _nwake= nwake;
+  _wakecount= 0;
   _slaveaddr= slaveaddr;
+#ifndef CCS811_NO_WIRE
+  _bus= bus ? bus : &ccs811_wirebus;
+#else
+  _bus= bus;
+#endif
+  _nint= nint;
+  _intslot= -1;
+  _thresh= false;
+  _mode= CCS811_MODE_IDLE;
+  _mailbox= -1;
   _i2cdelay_us= 0;
+  _rdstate= CCS811_RDSTATE_IDLE;
+  _flstate= CCS811_FLSTATE_IDLE;
+  _adaptive= false;
+  memset(&_timing,0,sizeof _timing);
+  _envvalid= false;
+  _envband_t= 0;
+  _envband_h= 0;
+  _envmaxage_ms= 0;
+  _envdeadband= false;
+  _envsuppressed= 0;
   wake_init();
 }
 
 
+// Releases the interrupt attached to nINT (if any).
+CCS811::~CCS811() {
+  if( _intslot<0 ) return;
+  detachInterrupt(digitalPinToInterrupt(_nint));
+  int_clear();
+  ccs811_int_used&= ~(1<<_intslot);
+}
+
+
 // Reset the CCS811, switch to app mode and check HW_ID. Returns false on problems.
 bool CCS811::begin( void ) {
   uint8_t sw_reset[]= {0x11,0xE5,0x72,0x8A};
@@ -83,6 +215,13 @@ bool CCS811::begin( void ) {
   uint8_t status;
   bool ok;
 
+  // Attach interrupt to nINT (done here, not in the constructor, because interrupts are not yet available for globals)
+  int_init();
+
+  // The reset below brings the CCS811 back to idle, with default ENV_DATA
+  _mode= CCS811_MODE_IDLE;
+  _envvalid= false;
+
   // Wakeup CCS811
   wake_up();
 
@@ -108,10 +247,8 @@ bool CCS811::begin( void ) {
       PRINTLN(F("ccs811: reset failed"));
       goto abort_begin;
     }
-    delayMicroseconds(CCS811_WAIT_AFTER_RESET_US);
-
-    // Check that HW_ID is 0x81
-    ok= i2cread(CCS811_HW_ID,1,&hw_id);
+    // Check that HW_ID is 0x81 (after the reset completed)
+    ok= wait_read(CCS811_WAIT_AFTER_RESET_US,CCS811_HW_ID,1,&hw_id,0x00,&_timing.reset_us);
     if( !ok ) {
       PRINTLN(F("ccs811: HW_ID read failed"));
       goto abort_begin;
@@ -160,10 +297,8 @@ bool CCS811::begin( void ) {
       PRINTLN(F("ccs811: Goto app mode failed"));
       goto abort_begin;
     }
-    delayMicroseconds(CCS811_WAIT_AFTER_APPSTART_US);
-
-    // Check if the switch was successful
-    ok= i2cread(CCS811_STATUS,1,&status);
+    // Check if the switch was successful (FW_MODE set)
+    ok= wait_read(CCS811_WAIT_AFTER_APPSTART_US,CCS811_STATUS,1,&status,CCS811_ERRSTAT_FW_MODE,&_timing.appstart_us);
     if( !ok ) {
       PRINTLN(F("ccs811: STATUS read (app mode) failed"));
       goto abort_begin;
@@ -187,45 +322,135 @@ abort_begin:
 }
 
 
-// Switch CCS811 to `mode`, use constants CCS811_MODE_XXX. Returns false on I2C problems.
+// As begin(), but when the CCS811 already runs (app mode with a valid app, no error, measuring in a valid MEAS_MODE) it is resumed without reset.
+// So the algorithm state and baseline the CCS811 built up survive a reboot (watchdog, OTA) of the host, when the CCS811 stays powered.
+// When resumed, get_mode() returns the drive mode from MEAS_MODE (no start() needed); when the interrupt flags in MEAS_MODE
+// differ from what start() writes (nINT, set_thresholds), start() rewrites them. Otherwise (also when idle), falls back to begin().
+bool CCS811::begin_warm( void ) {
+  uint8_t status;
+  uint8_t hw_id;
+  uint8_t app_version[2];
+  uint8_t meas_mode;
+  bool ok;
+
+  // Attach interrupt to nINT
+  int_init();
+
+  // The ENV_DATA in the CCS811 is not known
+  _envvalid= false;
+
+  // Wakeup CCS811
+  wake_up();
+
+    // Check status (app mode with valid app, no error)
+    ok= i2cread(CCS811_STATUS,1,&status);
+    if( !ok || (status&(CCS811_ERRSTAT_FW_MODE|CCS811_ERRSTAT_APP_VALID|CCS811_ERRSTAT_ERROR))!=(CCS811_ERRSTAT_FW_MODE|CCS811_ERRSTAT_APP_VALID) ) goto cold_begin;
+
+    // Check that HW_ID is 0x81
+    ok= i2cread(CCS811_HW_ID,1,&hw_id);
+    if( !ok || hw_id!=0x81 ) goto cold_begin;
+
+    // Read the application version
+    ok= i2cread(CCS811_FW_APP_VERSION,2,app_version);
+    if( !ok ) goto cold_begin;
+
+    // Check that MEAS_MODE has a valid drive mode, and is measuring (idle has nothing to resume)
+    ok= i2cread(CCS811_MEAS_MODE,1,&meas_mode);
+    if( !ok || (meas_mode&CCS811_MEAS_MODE_RESERVED)!=0 || (meas_mode>>4)>CCS811_MODE_250MS || (meas_mode>>4)==CCS811_MODE_IDLE ) goto cold_begin;
+
+  // CCS811 back to sleep
+  wake_down();
+  _appversion= app_version[0]*256+app_version[1];
+  _mode= meas_mode>>4;
+  PRINT(F("ccs811: warm start, mode "));
+  PRINTLN(_mode);
+  // The previous host may have configured the interrupts differently (nINT, thresholds); start() rewrites them (in the same drive mode)
+  if( meas_mode!=meas_mode_for(_mode) ) return start(_mode);
+  return true;
+
+cold_begin:
+  // CCS811 back to sleep
+  wake_down();
+  // Not running: reset
+  PRINTLN(F("ccs811: not running, cold start"));
+  return begin();
+}
+
+
+// The MEAS_MODE value start(`mode`) writes: the drive mode, plus the interrupt flags for nINT and thresholds.
+uint8_t CCS811::meas_mode_for( int mode ) {
+  uint8_t meas_mode= mode<<4;
+  if( _nint>=0 && mode!=CCS811_MODE_IDLE ) meas_mode|= CCS811_MEAS_MODE_INT_DATARDY;
+  if( _nint>=0 && mode!=CCS811_MODE_IDLE && _thresh ) meas_mode|= CCS811_MEAS_MODE_INT_THRESH;
+  return meas_mode;
+}
+
+
+// Switch CCS811 to `mode`, use constants CCS811_MODE_XXX. Enables the data-ready interrupt when nINT is connected. Returns false on I2C problems.
+// After set_thresholds(), the interrupt is only raised when eCO2 changes band.
 bool CCS811::start( int mode ) {
-  uint8_t meas_mode[]= {(uint8_t)(mode<<4)};
+  uint8_t meas_mode[]= {meas_mode_for(mode)};
+  int_clear();
   wake_up();
   bool ok = i2cwrite(CCS811_MEAS_MODE,1,meas_mode);
   wake_down();
+  if( ok ) _mode= mode;
   return ok;
 }
 
 
+// Merges STATUS and ERROR_ID from ALG_RESULT_DATA in `buf` to an errstat (flags CCS811_ERRSTAT_I2CFAIL if !ok)
+static uint16_t ccs811_errstat(bool ok, const uint8_t * buf) {
+  uint16_t combined = buf[5]*256+buf[4];
+  if( combined & ~(CCS811_ERRSTAT_HWERRORS|CCS811_ERRSTAT_OK) ) ok= false; // Unused bits are 1: I2C transfer error
+  combined &= CCS811_ERRSTAT_HWERRORS|CCS811_ERRSTAT_OK; // Clear all unused bits
+  if( !ok ) combined |= CCS811_ERRSTAT_I2CFAIL;
+  return combined;
+}
+
+
+// Copies the fields of ALG_RESULT_DATA in `buf` and `combined` to the (non-NULL) outputs
+static void ccs811_output(const uint8_t * buf, uint16_t combined, uint16_t*eco2, uint16_t*etvoc, uint16_t*errstat,uint16_t*raw) {
+  if( eco2   ) *eco2   = buf[0]*256+buf[1];
+  if( etvoc  ) *etvoc  = buf[2]*256+buf[3];
+  if( errstat) *errstat= combined;
+  if( raw    ) *raw    = buf[6]*256+buf[7];
+}
+
+
 // Get measurement results from the CCS811 (all args may be NULL), check status via errstat, e.g. ccs811_errstat(errstat)
+// Bus cost per sample (one transaction is START..STOP, the register select is a repeated START within it):
+//   firmware 2.x   1 transaction: ALG_RESULT_DATA (no select when ALG_RESULT_DATA is still selected by the previous read)
+//   firmware <2.0  2 transactions: STATUS and ALG_RESULT_DATA (they are separate mailboxes, and reading 
+//                  ALG_RESULT_DATA clears DATA_READY), 1 transaction when no sample is ready
+//   HW errors      1 extra transaction to clear ERROR_ID, in the same wake window
+// Only the shortest prefix of ALG_RESULT_DATA that covers the non-NULL args is transferred:
+// 2 bytes for eco2, 4 with etvoc, 6 with errstat, 8 with raw. Without errstat, ERROR_ID is not cleared.
 void CCS811::read( uint16_t*eco2, uint16_t*etvoc, uint16_t*errstat,uint16_t*raw) {
   bool    ok;
   uint8_t buf[8];
   uint8_t stat;
+  int     count= raw ? 8 : errstat ? 6 : etvoc ? 4 : 2;
+  memset(buf,0,sizeof buf); // Bytes beyond `count` read as 0 (so no status, no error)
+  int_clear();
   wake_up();
     if( _appversion<0x2000 ) {
       ok= i2cread(CCS811_STATUS,1,&stat); // CCS811 with pre 2.0.0 firmware has wrong STATUS in CCS811_ALG_RESULT_DATA
-      if( ok && stat==CCS811_ERRSTAT_OK ) ok= i2cread(CCS811_ALG_RESULT_DATA,8,buf); else buf[5]=0;
+      if( ok && stat==CCS811_ERRSTAT_OK ) ok= i2cread(CCS811_ALG_RESULT_DATA,count,buf); else buf[5]=0;
       buf[4]= stat; // Update STATUS field with correct STATUS
     } else {
-      ok = i2cread(CCS811_ALG_RESULT_DATA,8,buf);
+      ok = i2cread(CCS811_ALG_RESULT_DATA,count,buf);
+    }
+    // Status and error management
+    uint16_t combined = ccs811_errstat(ok,buf);
+    // Clear ERROR_ID if flags are set (still awake, so no second wake-up)
+    if( combined & CCS811_ERRSTAT_HWERRORS ) {
+      uint8_t err;
+      if( !i2cread(CCS811_ERROR_ID,1,&err) ) combined |= CCS811_ERRSTAT_I2CFAIL; // Propagate I2C error
     }
   wake_down();
-  // Status and error management
-  uint16_t combined = buf[5]*256+buf[4];
-  if( combined & ~(CCS811_ERRSTAT_HWERRORS|CCS811_ERRSTAT_OK) ) ok= false; // Unused bits are 1: I2C transfer error
-  combined &= CCS811_ERRSTAT_HWERRORS|CCS811_ERRSTAT_OK; // Clear all unused bits
-  if( !ok ) combined |= CCS811_ERRSTAT_I2CFAIL;
-  // Clear ERROR_ID if flags are set
-  if( combined & CCS811_ERRSTAT_HWERRORS ) {
-      int err = get_errorid();
-      if( err==-1 ) combined |= CCS811_ERRSTAT_I2CFAIL; // Propagate I2C error
-  }
   // Outputs
-  if( eco2   ) *eco2   = buf[0]*256+buf[1];
-  if( etvoc  ) *etvoc  = buf[2]*256+buf[3];
-  if( errstat) *errstat= combined;
-  if( raw    ) *raw    = buf[6]*256+buf[7];;
+  ccs811_output(buf,combined,eco2,etvoc,errstat,raw);
 }
 
 
@@ -308,34 +533,62 @@ int CCS811::get_errorid(void) {
 }
 
 
+// Returns the mode of the last successful start() since begin() (CCS811_MODE_IDLE if none).
+int CCS811::get_mode(void) {
+  return _mode;
+}
+
+
+// Returns the I2C transport of this CCS811.
+CCS811Bus * CCS811::get_bus(void) {
+  return _bus;
+}
+
+
+// Adaptive timing: begin() and flash() poll the CCS811 until it is ready, instead of waiting the fixed worst case.
+// This relies on the CCS811 not ACKing while busy, which the datasheet does not state (not verified on hardware).
+// Polls never repeat a command: they read or select STATUS, and APP_DATA and APP_VERIFY are sent once the CCS811 ACKs.
+// Polling is bounded (CCS811_ADAPTIVE_TIMEOUT_MUL times the fixed wait).
+void CCS811::set_adaptive_timing(bool adaptive) {
+  _adaptive= adaptive;
+}
+
+
+// Copies the timings observed with adaptive timing to `timing` (0 for a step not yet observed).
+void CCS811::get_timing(CCS811Timing * timing) {
+  *timing= _timing;
+}
+
+
 #define HI(u16) ( (uint8_t)( ((u16)>>8)&0xFF ) )
 #define LO(u16) ( (uint8_t)( ((u16)>>0)&0xFF ) )
 
 
 // Writes t and h to ENV_DATA (see datasheet for CCS811 format). Returns false on I2C problems.
+// With a dead-band (see set_envdata_deadband), a write close to the last one is skipped (and returns true).
 bool CCS811::set_envdata(uint16_t t, uint16_t h) {
+  if( _envvalid && _envdeadband && (_envmaxage_ms==0 || millis()-_envtime_ms<_envmaxage_ms) ) {
+    uint16_t dt= t>_envt ? t-_envt : _envt-t;
+    uint16_t dh= h>_envh ? h-_envh : _envh-h;
+    if( dt<=_envband_t && dh<=_envband_h ) { _envsuppressed++; return true; }
+  }
   uint8_t envdata[]= { HI(h), LO(h), HI(t), LO(t) };
   wake_up();
   // Serial.print(" [T="); Serial.print(t); Serial.print(" H="); Serial.print(h); Serial.println("] ");
   bool ok = i2cwrite(CCS811_ENV_DATA,4,envdata);
   wake_down();
+  _envvalid= ok;
+  _envt= t;
+  _envh= h;
+  _envtime_ms= millis();
   return ok;
 }
 
 
 // Writes t and h (in ENS210 format) to ENV_DATA. Returns false on I2C problems.
 bool CCS811::set_envdata210(uint16_t t, uint16_t h) {
-  // Humidity formats of ENS210 and CCS811 are equal, we only need to map temperature.
-  // The lowest and highest (raw) ENS210 temperature values the CCS811 can handle
-  uint16_t lo= 15882; // (273.15-25)*64 = 15881.6 (float to int error is 0.4)
-  uint16_t hi= 24073; // 65535/8+lo = 24073.875 (24074 would map to 65539, so overflow)
-  // Check if ENS210 temperature is within CCS811 range, if not clip, if so map
-  bool ok;
-  if( t<lo )      ok= set_envdata(0,h);
-  else if( t>hi ) ok= set_envdata(65535,h);
-  else            ok= set_envdata( (t-lo)*8+3 , h); // error in 'lo' is 0.4; times 8 is 3.2; so we correct 3
-  // Returns I2C transaction status
-  return ok;
+  // Humidity formats of ENS210 and CCS811 are equal, we only need to map temperature (see envdata_t_ens210).
+  return set_envdata( envdata_t_ens210(t), h );
 }
 
 // Writes t (in Celsius) and h (in percentage RH) to ENV_DATA. Returns false on I2C problems.
@@ -349,6 +602,46 @@ bool CCS811::set_envdata_Celsius_percRH(float t, float h) {
 }
 
 
+// Writes t (in milli Celsius) and h (in milli percentage RH) to ENV_DATA, without floats. Returns false on I2C problems.
+// E.g. 23.5C and 48.5%RH are set_envdata_mCelsius_mpercRH(23500,48500); both map to 0x6100.
+bool CCS811::set_envdata_mCelsius_mpercRH(int32_t t, int32_t h) {
+  return set_envdata( envdata_t_mCelsius(t), envdata_h_mpercRH(h) );
+}
+
+
+// The integer conversions are constexpr, so they are checked at compile time against the datasheet examples,
+// against the float formula (t+25)*512 (rounded), and against the previous ENS210 mapping (t-15882)*8+3
+static_assert( CCS811::envdata_t_mCelsius(23500)==0x6100 && CCS811::envdata_h_mpercRH(48500)==0x6100, "ENV_DATA datasheet example" );
+static_assert( CCS811::envdata_t_mCelsius(-25000)==0 && CCS811::envdata_t_mCelsius(-40000)==0 && CCS811::envdata_t_mCelsius(0)==12800, "ENV_DATA temperature low end" );
+static_assert( CCS811::envdata_t_mCelsius(102998)==65535 && CCS811::envdata_t_mCelsius(200000)==65535 && CCS811::envdata_t_mCelsius(85000)==56320, "ENV_DATA temperature high end" );
+static_assert( CCS811::envdata_t_mCelsius(21357)==23735 && CCS811::envdata_t_mCelsius(-12345)==6479, "ENV_DATA temperature rounding" ); // 23734.8, 6479.4
+static_assert( CCS811::envdata_h_mpercRH(0)==0 && CCS811::envdata_h_mpercRH(-1)==0 && CCS811::envdata_h_mpercRH(100000)==51200 && CCS811::envdata_h_mpercRH(200000)==65535, "ENV_DATA humidity ends" );
+static_assert( CCS811::envdata_h_mpercRH(33333)==17066 && CCS811::envdata_h_mpercRH(127998)==65535, "ENV_DATA humidity rounding" ); // 17066.496, 65534.976
+static_assert( CCS811::envdata_t_ens210(15881)==0 && CCS811::envdata_t_ens210(15882)==3 && CCS811::envdata_t_ens210(19000)==(19000-15882)*8+3, "ENS210 mapping" );
+static_assert( CCS811::envdata_t_ens210(24073)==65531 && CCS811::envdata_t_ens210(24074)==65535, "ENS210 mapping high end" );
+
+
+// Compensation interface: change-suppressed ENV_DATA writes ==========================================================
+
+
+// set_envdata (and its variants) skip the write when t and h (in ENV_DATA units, 1/512 C resp. 1/512 %RH) are within 
+// `t` resp. `h` of the last write, and that write is younger than `maxage_ms`. E.g. (256,512,60000) for 0.5C, 1%RH, a minute.
+// A `maxage_ms` of 0 means no maximum age: only a change beyond the dead-band writes. All 0 (the default) disables the 
+// dead-band: every call writes. The last write is forgotten by begin() (its reset restores the default ENV_DATA).
+void CCS811::set_envdata_deadband(uint16_t t, uint16_t h, unsigned long maxage_ms) {
+  _envband_t= t;
+  _envband_h= h;
+  _envmaxage_ms= maxage_ms;
+  _envdeadband= t!=0 || h!=0 || maxage_ms!=0;
+}
+
+
+// Returns the number of ENV_DATA writes skipped by the dead-band (since construction).
+uint32_t CCS811::get_envdata_suppressed(void) {
+  return _envsuppressed;
+}
+
+
 // Reads (encoded) baseline from BASELINE. Returns false on I2C problems. 
 // Get it, just before power down (but only when sensor was on at least 20min) - see CCS811_AN000370.
 bool CCS811::get_baseline(uint16_t *baseline) {
@@ -372,157 +665,601 @@ bool CCS811::set_baseline(uint16_t baseline) {
 
 
 // Flashes the firmware of the CCS811 with size bytes from image - image _must_ be in PROGMEM.
+// Blocking version of flash_begin()/flash_poll(): it waits (delay) where flash_poll() would return.
 bool CCS811::flash(const uint8_t * image, int size) {
+  return flash_begin(image,size) && flash_run();
+}
+
+
+// As flash(), but the `size` image bytes come from `reader` (called with `context`), one 8 byte block at a time.
+bool CCS811::flash(CCS811FlashReader reader, void * context, int size) {
+  return flash_begin(reader,context,size) && flash_run();
+}
+
+
+// CCS811FlashReader for a Stream (`context`); the stream is read sequentially, so `pos` is not needed.
+static int ccs811_stream_reader(void * context, uint8_t * buf, int pos, int len) {
+  (void)pos;
+  return ((Stream*)context)->readBytes(buf,len);
+}
+
+
+// As flash(), but reads the `size` image bytes from `stream` (e.g. an SD File or Serial), one 8 byte block at a time.
+// The stream's timeout (setTimeout) applies to each block.
+bool CCS811::flash(Stream & stream, int size) {
+  return flash(ccs811_stream_reader,&stream,size);
+}
+
+
+// Asynchronous interface: non-blocking flash ========================================================================
+
+
+// Starts flashing `size` bytes of `image` (PROGMEM); advance it with flash_poll(). Returns false when a flash or read is in progress.
+// The optional `progress` is called after each block written to APP_DATA.
+// nWAKE stays low until the flash is done (or failed). Do not call other CCS811 functions while flashing.
+bool CCS811::flash_begin(const uint8_t * image, int size, CCS811FlashProgress progress) {
+  if( _flstate!=CCS811_FLSTATE_IDLE || _rdstate!=CCS811_RDSTATE_IDLE ) return false;
+  _flimage= image;
+  _flreader= 0;
+  _flsize= size;
+  _flpos= 0;
+  _flprogress= progress;
+  // As wake_up(), but the wait is done by flash_poll()
+  _flstate= CCS811_FLSTATE_PING;
+  _fltime_us= micros();
+  _flwait_us= _nwake>=0 && _wakecount==0 ? CCS811_WAIT_AFTER_WAKE_US : 0;
+  if( _wakecount++ == 0 && _nwake>=0 ) digitalWrite(_nwake, LOW);
+  return true;
+}
+
+
+// As flash_begin(), but the `size` image bytes come from `reader` (called with `context`), one 8 byte block at a time.
+// Only that block is kept in RAM; the image need not be in PROGMEM.
+bool CCS811::flash_begin(CCS811FlashReader reader, void * context, int size, CCS811FlashProgress progress) {
+  if( !flash_begin((const uint8_t*)0,size,progress) ) return false;
+  _flreader= reader;
+  _flcontext= context;
+  return true;
+}
+
+
+// Waits `us` (also more than delayMicroseconds supports)
+static void ccs811_wait_us(unsigned long us) {
+  if( us>=1000 ) delay(us/1000);
+  if( us%1000>0 ) delayMicroseconds(us%1000);
+}
+
+
+// Runs the flash begun by flash_begin() to its end, waiting where flash_poll() would return. Returns true when flashed.
+bool CCS811::flash_run(void) {
+  int res;
+  while( (res=flash_poll())==CCS811_FLASH_BUSY ) ccs811_wait_us(flash_wait_us());
+  return res==CCS811_FLASH_DONE;
+}
+
+
+// Time in us until flash_poll() can do its next step (0 when it can do it now, or when no flash is in progress).
+unsigned long CCS811::flash_wait_us(void) {
+  if( _flstate==CCS811_FLSTATE_IDLE ) return 0;
+  unsigned long passed= micros()-_fltime_us;
+  return passed>=_flwait_us ? 0 : _flwait_us-passed;
+}
+
+
+// Next step of the flash is `state`, after waiting `wait_us` (with adaptive timing: the first poll of that wait)
+void CCS811::flash_next(uint8_t state, unsigned long wait_us) {
+  _flstate= state;
+  _fltime_us= micros();
+  _flstep_us= _fltime_us;
+  _flfixed_us= wait_us;
+  _flwait_us= _adaptive ? wait_us/CCS811_ADAPTIVE_FIRST_DIV : wait_us;
+}
+
+
+// With adaptive timing, a step that found the CCS811 not yet ready is retried later; returns false when it may not (timeout).
+bool CCS811::flash_retry(void) {
+  if( !_adaptive ) return false;
+  unsigned long now= micros();
+  if( now-_flstep_us >= _flfixed_us*CCS811_ADAPTIVE_TIMEOUT_MUL ) return false;
+  _fltime_us= now;
+  _flwait_us= _flfixed_us/CCS811_ADAPTIVE_POLL_DIV;
+  return true;
+}
+
+
+// With adaptive timing, records in `*took_us` how long the CCS811 needed for the previous step
+void CCS811::flash_took(unsigned long * took_us, bool max) {
+  if( !_adaptive || _flfixed_us==0 ) return;
+  unsigned long took= micros()-_flstep_us;
+  if( !max || took>*took_us ) *took_us= took;
+}
+
+
+// Does the next step (at most one I2C transaction) of the flash started by flash_begin(), unless its wait is not yet over.
+// Returns CCS811_FLASH_BUSY (call again), CCS811_FLASH_DONE or CCS811_FLASH_FAILED (also when no flash was begun).
+// The steps and status checks are those of flash(): ping, reset, erase, write blocks, verify, reset.
+int CCS811::flash_poll(void) {
   uint8_t sw_reset[]=   {0x11,0xE5,0x72,0x8A};
   uint8_t app_erase[]=  {0xE7,0xA7,0xE6,0x09};
   uint8_t app_verify[]= {};
   uint8_t status;
-  int count;
   bool ok;
-  wake_up();
-
-    // Try to ping CCS811 (can we reach CCS811 via I2C?)
-    PRINT(F("ccs811: ping "));
-    ok= i2cwrite(0,0,0);
-    if( !ok ) {
-      PRINTLN(F("FAILED"));
-      goto abort_begin;
-    }
-    PRINTLN(F("ok"));
+  if( _flstate==CCS811_FLSTATE_IDLE ) return CCS811_FLASH_FAILED;
+  if( flash_wait_us()>0 ) return CCS811_FLASH_BUSY;
+  switch( _flstate ) {
 
-    // Invoke a SW reset (bring CCS811 in a know state)
-    PRINT(F("ccs811: reset "));
-    ok= i2cwrite(CCS811_SW_RESET,4,sw_reset);
-    if( !ok ) {
-      PRINTLN(F("FAILED"));
-      goto abort_begin;
+    case CCS811_FLSTATE_PING :
+      // Try to ping CCS811 (can we reach CCS811 via I2C?)
+      PRINT(F("ccs811: ping "));
+      ok= i2cwrite(0,0,0);
+      if( !ok ) {
+        PRINTLN(F("FAILED"));
+        goto abort_flash;
+      }
+      PRINTLN(F("ok"));
+      flash_next(CCS811_FLSTATE_RESET1,0);
+      return CCS811_FLASH_BUSY;
+
+    case CCS811_FLSTATE_RESET1 :
+      // Invoke a SW reset (bring CCS811 in a know state)
+      PRINT(F("ccs811: reset "));
+      ok= i2cwrite(CCS811_SW_RESET,4,sw_reset);
+      if( !ok ) {
+        PRINTLN(F("FAILED"));
+        goto abort_flash;
+      }
+      PRINTLN(F("ok"));
+      flash_next(CCS811_FLSTATE_STATUS1,CCS811_WAIT_AFTER_RESET_US);
+      return CCS811_FLASH_BUSY;
+
+    case CCS811_FLSTATE_STATUS1 :
+      // Check status (after reset, CCS811 should be in boot mode with or without valid app)
+      ok= i2cread(CCS811_STATUS,1,&status);
+      if( !ok && flash_retry() ) return CCS811_FLASH_BUSY;
+      flash_took(&_timing.reset_us,false);
+      PRINT(F("ccs811: status (reset1) "));
+      if( !ok ) {
+        PRINTLN(F("FAILED"));
+        goto abort_flash;
+      }
+      PRINT2(status,HEX);
+      PRINT(F(" "));
+      if( status!=0x00 && status!=0x10 ) {
+        PRINTLN(F("ERROR - ignoring")); // Seems to happens when there is no valid app
+      } else {
+        PRINTLN(F("ok"));
+      }
+      flash_next(CCS811_FLSTATE_ERASE,0);
+      return CCS811_FLASH_BUSY;
+
+    case CCS811_FLSTATE_ERASE :
+      // Invoke app erase
+      PRINT(F("ccs811: app-erase "));
+      ok= i2cwrite(CCS811_APP_ERASE,4,app_erase);
+      if( !ok ) {
+        PRINTLN(F("FAILED"));
+        goto abort_flash;
+      }
+      PRINTLN(F("ok"));
+      flash_next(CCS811_FLSTATE_STATUSERASE,CCS811_WAIT_AFTER_APPERASE_MS*1000UL);
+      return CCS811_FLASH_BUSY;
+
+    case CCS811_FLSTATE_STATUSERASE :
+      // Check status (CCS811 should be in boot mode without valid app, with erase completed)
+      ok= i2cread(CCS811_STATUS,1,&status);
+      if( (!ok || status!=0x40) && flash_retry() ) return CCS811_FLASH_BUSY;
+      flash_took(&_timing.erase_us,false);
+      PRINT(F("ccs811: status (app-erase) "));
+      if( !ok ) {
+        PRINTLN(F("FAILED"));
+        goto abort_flash;
+      }
+      PRINT2(status,HEX);
+      PRINT(F(" "));
+      if( status!=0x40 ) {
+        PRINTLN(F("ERROR"));
+        goto abort_flash;
+      }
+      PRINTLN(F("ok"));
+      flash_next(_flsize>0 ? CCS811_FLSTATE_DATA : CCS811_FLSTATE_VERIFY,0);
+      return CCS811_FLASH_BUSY;
+
+    case CCS811_FLSTATE_DATA : {
+      // Write one block
+      int count= _flpos/8;
+      int size= _flsize-_flpos;
+      int len= size<8 ? size : 8;
+      uint8_t block[8];
+      // With adaptive timing, probe by selecting STATUS (no state change) until the previous block is processed: a block is sent once
+      ok= true;
+      if( _adaptive ) {
+        ok= i2cwrite(CCS811_STATUS,0,0);
+        if( !ok && flash_retry() ) return CCS811_FLASH_BUSY; // Previous block not yet processed (NACK)
+        flash_took(&_timing.appdata_us,true);
+      }
+      if( count%64==0 ) { PRINT(F("ccs811: writing ")); PRINT(size); PRINT(F(" ")); }
+      // Copy the block to RAM (from PROGMEM or the reader)
+      if( _flreader==0 ) memcpy_P(block, _flimage+_flpos, len);
+      else if( _flreader(_flcontext,block,_flpos,len)!=len ) {
+        PRINTLN(F("ccs811: image read failed"));
+        goto abort_flash;
+      }
+      // Send 8 bytes from RAM to CCS811
+      if( ok ) ok= i2cwrite(CCS811_APP_DATA,len,block);
+      if( !ok ) {
+        PRINTLN(F("ccs811: app data failed"));
+        goto abort_flash;
+      }
+      PRINT(F("."));
+      _flpos+= len;
+      size-= len;
+      count++;
+      if( count%64==0 || size==0 ) { PRINT(F(" ")); PRINTLN(size); }
+      if( _flprogress ) _flprogress(this,_flpos,_flsize);
+      flash_next(size>0 ? CCS811_FLSTATE_DATA : CCS811_FLSTATE_VERIFY,CCS811_WAIT_AFTER_APPDATA_MS*1000UL);
+      return CCS811_FLASH_BUSY;
     }
-    delayMicroseconds(CCS811_WAIT_AFTER_RESET_US);
-    PRINTLN(F("ok"));
 
-    // Check status (after reset, CCS811 should be in boot mode with or without valid app)
-    PRINT(F("ccs811: status (reset1) "));
-    ok= i2cread(CCS811_STATUS,1,&status);
-    if( !ok ) {
-      PRINTLN(F("FAILED"));
-      goto abort_begin;
-    }
-    PRINT2(status,HEX);
-    PRINT(F(" "));
-    if( status!=0x00 && status!=0x10 ) {
-      PRINTLN(F("ERROR - ignoring")); // Seems to happens when there is no valid app
-    } else {
+    case CCS811_FLSTATE_VERIFY :
+      // With adaptive timing, probe by selecting STATUS (no state change) until the last block is processed: verify is invoked once
+      ok= true;
+      if( _adaptive ) {
+        ok= i2cwrite(CCS811_STATUS,0,0);
+        if( !ok && flash_retry() ) return CCS811_FLASH_BUSY; // Last block not yet processed (NACK)
+        flash_took(&_timing.appdata_us,true);
+      }
+      // Invoke app verify
+      if( ok ) ok= i2cwrite(CCS811_APP_VERIFY,0,app_verify);
+      PRINT(F("ccs811: app-verify "));
+      if( !ok ) {
+        PRINTLN(F("FAILED"));
+        goto abort_flash;
+      }
       PRINTLN(F("ok"));
-    }
+      flash_next(CCS811_FLSTATE_STATUSVERIFY,CCS811_WAIT_AFTER_APPVERIFY_MS*1000UL);
+      return CCS811_FLASH_BUSY;
+
+    case CCS811_FLSTATE_STATUSVERIFY :
+      // Check status (CCS811 should be in boot mode with valid app, and erased and verified)
+      ok= i2cread(CCS811_STATUS,1,&status);
+      if( (!ok || status!=0x30) && flash_retry() ) return CCS811_FLASH_BUSY;
+      flash_took(&_timing.verify_us,false);
+      PRINT(F("ccs811: status (app-verify) "));
+      if( !ok ) {
+        PRINTLN(F("FAILED"));
+        goto abort_flash;
+      }
+      PRINT2(status,HEX);
+      PRINT(F(" "));
+      if( status!=0x30 ) {
+        PRINTLN(F("ERROR"));
+        goto abort_flash;
+      }
+      PRINTLN(F("ok"));
+      flash_next(CCS811_FLSTATE_RESET2,0);
+      return CCS811_FLASH_BUSY;
+
+    case CCS811_FLSTATE_RESET2 :
+      // Invoke a second SW reset (clear flashing flags)
+      PRINT(F("ccs811: reset2 "));
+      ok= i2cwrite(CCS811_SW_RESET,4,sw_reset);
+      if( !ok ) {
+        PRINTLN(F("FAILED"));
+        goto abort_flash;
+      }
+      PRINTLN(F("ok"));
+      flash_next(CCS811_FLSTATE_STATUS2,CCS811_WAIT_AFTER_RESET_US);
+      return CCS811_FLASH_BUSY;
+
+    case CCS811_FLSTATE_STATUS2 :
+      // Check status (after reset, CCS811 should be in boot mode with valid app)
+      ok= i2cread(CCS811_STATUS,1,&status);
+      if( !ok && flash_retry() ) return CCS811_FLASH_BUSY;
+      flash_took(&_timing.reset_us,false);
+      PRINT(F("ccs811: status (reset2) "));
+      if( !ok ) {
+        PRINTLN(F("FAILED"));
+        goto abort_flash;
+      }
+      PRINT2(status,HEX);
+      PRINT(F(" "));
+      if( status!=0x10 ) {
+        PRINTLN(F("ERROR"));
+        goto abort_flash;
+      }
+      PRINTLN(F("ok"));
+      // CCS811 back to sleep
+      _flstate= CCS811_FLSTATE_IDLE;
+      wake_down();
+      // Return success
+      return CCS811_FLASH_DONE;
+  }
 
-    // Invoke app erase
-    PRINT(F("ccs811: app-erase "));
-    ok= i2cwrite(CCS811_APP_ERASE,4,app_erase);
-    if( !ok ) {
-      PRINTLN(F("FAILED"));
-      goto abort_begin;
-    }
-    delay(CCS811_WAIT_AFTER_APPERASE_MS);
-    PRINTLN(F("ok"));
+abort_flash:
+  // CCS811 back to sleep
+  _flstate= CCS811_FLSTATE_IDLE;
+  wake_down();
+  // Return failure
+  return CCS811_FLASH_FAILED;
+}
 
-    // Check status (CCS811 should be in boot mode without valid app, with erase completed)
-    PRINT(F("ccs811: status (app-erase) "));
-    ok= i2cread(CCS811_STATUS,1,&status);
-    if( !ok ) {
-      PRINTLN(F("FAILED"));
-      goto abort_begin;
-    }
-    PRINT2(status,HEX);
-    PRINT(F(" "));
-    if( status!=0x40 ) {
-      PRINTLN(F("ERROR"));
-      goto abort_begin;
-    }
-    PRINTLN(F("ok"));
-
-    // Write all blocks
-    count= 0;
-    while( size>0 ) {
-        if( count%64==0 ) { PRINT(F("ccs811: writing ")); PRINT(size); PRINT(F(" ")); }
-        int len= size<8 ? size : 8;
-        // Copy PROGMEM to RAM
-        uint8_t ram[8];
-        memcpy_P(ram, image, len);
-        // Send 8 bytes from RAM to CCS811
-        ok= i2cwrite(CCS811_APP_DATA,len, ram);
-        if( !ok ) {
-          PRINTLN(F("ccs811: app data failed"));
-          goto abort_begin;
-        }
-        PRINT(F("."));
-        delay(CCS811_WAIT_AFTER_APPDATA_MS);
-        image+= len;
-        size-= len;
-        count++;
-        if( count%64==0 ) { PRINT(F(" ")); PRINTLN(size); }
-    }
-    if( count%64!=0 ) { PRINT(F(" ")); PRINTLN(size); }
 
-    // Invoke app verify
-    PRINT(F("ccs811: app-verify "));
-    ok= i2cwrite(CCS811_APP_VERIFY,0,app_verify);
-    if( !ok ) {
-      PRINTLN(F("FAILED"));
-      goto abort_begin;
-    }
-    delay(CCS811_WAIT_AFTER_APPVERIFY_MS);
-    PRINTLN(F("ok"));
+// Image interface: firmware image container ========================================================================
 
-    // Check status (CCS811 should be in boot mode with valid app, and erased and verified)
-    PRINT(F("ccs811: status (app-verify) "));
-    ok= i2cread(CCS811_STATUS,1,&status);
-    if( !ok ) {
-      PRINTLN(F("FAILED"));
-      goto abort_begin;
-    }
-    PRINT2(status,HEX);
-    PRINT(F(" "));
-    if( status!=0x30 ) {
-      PRINTLN(F("ERROR"));
-      goto abort_begin;
-    }
-    PRINTLN(F("ok"));
 
-    // Invoke a second SW reset (clear flashing flags)
-    PRINT(F("ccs811: reset2 "));
-    ok= i2cwrite(CCS811_SW_RESET,4,sw_reset);
-    if( !ok ) {
-      PRINTLN(F("FAILED"));
-      goto abort_begin;
+// CRC-16/CCITT (polynomial 0x1021, start with 0xFFFF) of `count` bytes in `buf`, continuing from `crc`.
+static uint16_t ccs811_crc16(uint16_t crc, const uint8_t * buf, int count) {
+  for( int i=0; i<count; i++ ) {
+    crc^= buf[i]<<8;
+    for( int b=0; b<8; b++ ) crc= crc&0x8000 ? (crc<<1)^0x1021 : crc<<1;
+  }
+  return crc;
+}
+
+
+// The container of flash_image(header,image): both in PROGMEM
+struct ccs811_image_progmem_t {
+  const uint8_t * header;
+  const uint8_t * image;
+};
+
+
+// CCS811FlashReader for a ccs811_image_progmem_t (`context`)
+static int ccs811_image_progmem_reader(void * context, uint8_t * buf, int pos, int len) {
+  ccs811_image_progmem_t * container= (ccs811_image_progmem_t*)context;
+  for( int i=0; i<len; i++, pos++ ) {
+    buf[i]= pos<CCS811_IMAGE_HEADER_SIZE ? pgm_read_byte(container->header+pos) : pgm_read_byte(container->image+pos-CCS811_IMAGE_HEADER_SIZE);
+  }
+  return len;
+}
+
+
+// A container reader, seen as an image reader (skips the header)
+struct ccs811_image_reader_t {
+  CCS811FlashReader reader;
+  void * context;
+};
+
+
+// CCS811FlashReader for the image in the container of a ccs811_image_reader_t (`context`)
+static int ccs811_image_reader(void * context, uint8_t * buf, int pos, int len) {
+  ccs811_image_reader_t * container= (ccs811_image_reader_t*)context;
+  return container->reader(container->context,buf,CCS811_IMAGE_HEADER_SIZE+pos,len);
+}
+
+
+// Flashes the container with `header` and `image` (both PROGMEM), see flash_image(reader,context,force).
+int CCS811::flash_image(const uint8_t * header, const uint8_t * image, bool force) {
+  ccs811_image_progmem_t container= { header, image };
+  return flash_image(ccs811_image_progmem_reader,&container,force);
+}
+
+
+// Flashes the image container that comes from `reader` (header at pos 0). Returns one of CCS811_IMAGE_XXX.
+// First the header and the checksum of the image are validated, before anything is written to the CCS811 (so before APP_ERASE).
+// Next, unless `force`, the flash is skipped (CCS811_IMAGE_SKIPPED) when the CCS811 already has a valid app (STATUS has APP_VALID
+// and no ERROR) of the version of the image. After an interrupted or failed flash the CCS811 may still report the version.
+// The reader is called twice for each block: once for the checksum, once for the flash.
+int CCS811::flash_image(CCS811FlashReader reader, void * context, bool force) {
+  uint8_t  buf[CCS811_IMAGE_HEADER_SIZE];
+  uint16_t appversion;
+  int      size;
+  uint16_t crc;
+  ccs811_image_reader_t container= { reader, context };
+
+  // Validate header
+  if( reader(context,buf,0,CCS811_IMAGE_HEADER_SIZE)!=CCS811_IMAGE_HEADER_SIZE ) {
+    PRINTLN(F("ccs811: image header read failed"));
+    return CCS811_IMAGE_INVALID;
+  }
+  if( buf[0]!='C' || buf[1]!='8' || buf[2]!='1' || buf[3]!='1' || buf[4]!=CCS811_IMAGE_FORMAT || buf[5]!=0 ) {
+    PRINTLN(F("ccs811: image header invalid"));
+    return CCS811_IMAGE_INVALID;
+  }
+  appversion= (buf[6]<<8) + buf[7];
+  size= (buf[8]<<8) + buf[9];
+  crc= (buf[10]<<8) + buf[11];
+  if( size==0 || size%8!=0 ) {
+    PRINT(F("ccs811: image size invalid ")); PRINTLN(size);
+    return CCS811_IMAGE_INVALID;
+  }
+
+  // Validate checksum
+  uint16_t check= 0xFFFF;
+  for( int pos=0; pos<size; pos+=8 ) {
+    if( ccs811_image_reader(&container,buf,pos,8)!=8 ) {
+      PRINTLN(F("ccs811: image read failed"));
+      return CCS811_IMAGE_INVALID;
     }
-    delayMicroseconds(CCS811_WAIT_AFTER_RESET_US);
-    PRINTLN(F("ok"));
+    check= ccs811_crc16(check,buf,8);
+  }
+  if( check!=crc ) {
+    PRINT(F("ccs811: image checksum invalid ")); PRINT2(check,HEX); PRINT(F(" (expected ")); PRINT2(crc,HEX); PRINTLN(F(")"));
+    return CCS811_IMAGE_INVALID;
+  }
 
-    // Check status (after reset, CCS811 should be in boot mode with valid app)
-    PRINT(F("ccs811: status (reset2) "));
-    ok= i2cread(CCS811_STATUS,1,&status);
-    if( !ok ) {
-      PRINTLN(F("FAILED"));
-      goto abort_begin;
+  // Skip when installed (and valid)
+  if( !force ) {
+    uint8_t status;
+    wake_up();
+      bool valid= i2cread(CCS811_STATUS,1,&status) && (status&(CCS811_ERRSTAT_APP_VALID|CCS811_ERRSTAT_ERROR))==CCS811_ERRSTAT_APP_VALID;
+      int  version= application_version();
+    wake_down();
+    if( valid && version==appversion ) {
+      PRINT(F("ccs811: image version ")); PRINT2(appversion,HEX); PRINTLN(F(" already installed"));
+      return CCS811_IMAGE_SKIPPED;
     }
-    PRINT2(status,HEX);
-    PRINT(F(" "));
-    if( status!=0x10 ) {
-      PRINTLN(F("ERROR"));
-      goto abort_begin;
+  }
+
+  // Flash
+  PRINT(F("ccs811: flashing image version ")); PRINTLN2(appversion,HEX);
+  return flash(ccs811_image_reader,&container,size) ? CCS811_IMAGE_FLASHED : CCS811_IMAGE_FAILED;
+}
+
+
+// Asynchronous interface: non-blocking read =========================================================================
+
+
+// Starts a read that never waits; finish it by calling read_poll() (e.g. from loop()). Returns false when a read or flash is in progress.
+// The read takes the same steps as read(), but where read() would wait, read_poll() returns false.
+// Do not call other CCS811 functions until read_poll() returned true.
+bool CCS811::read_begin(void) {
+  if( _rdstate!=CCS811_RDSTATE_IDLE || _flstate!=CCS811_FLSTATE_IDLE ) return false;
+  int_clear();
+  memset(_rdbuf,0,sizeof _rdbuf); // As read(): fields not read (no data, I2C failure) are 0, not those of the previous read
+  // As wake_up(), but the wait is done by read_poll()
+  _rdstate= CCS811_RDSTATE_WAKE;
+  _rdtime_us= micros();
+  if( _wakecount++ == 0 ) {
+    if( _nwake>=0 ) digitalWrite(_nwake, LOW);
+  } else {
+    _rdtime_us-= CCS811_WAIT_AFTER_WAKE_US; // Already awake (in a wake session): no need to wait
+  }
+  return true;
+}
+
+
+// Advances the read started by read_begin(). Returns false while busy, true when done; then args are set as by read().
+// Also returns false when no read was begun.
+bool CCS811::read_poll(uint16_t*eco2, uint16_t*etvoc, uint16_t*errstat, uint16_t*raw) {
+  unsigned long wait_us= _rdstate==CCS811_RDSTATE_WAKE ? (_nwake>=0 ? CCS811_WAIT_AFTER_WAKE_US : 0) : _i2cdelay_us;
+  if( micros()-_rdtime_us < wait_us ) return false;
+  switch( _rdstate ) {
+    case CCS811_RDSTATE_IDLE :
+      return false;
+    case CCS811_RDSTATE_WAKE :
+      _rdok= true;
+      if( _appversion<0x2000 ) {
+        rd_select(CCS811_STATUS,CCS811_RDSTATE_STATUS); // CCS811 with pre 2.0.0 firmware has wrong STATUS in CCS811_ALG_RESULT_DATA
+      } else {
+        rd_select(CCS811_ALG_RESULT_DATA,CCS811_RDSTATE_RESULT);
+      }
+      return false;
+    case CCS811_RDSTATE_STATUS :
+      _rdok= i2cread_fetch(1,&_rdstat) && _rdok;
+      if( _rdok && _rdstat==CCS811_ERRSTAT_OK ) {
+        rd_select(CCS811_ALG_RESULT_DATA,CCS811_RDSTATE_RESULT);
+        return false;
+      }
+      _rdbuf[4]= _rdstat;
+      _rdbuf[5]= 0;
+      break;
+    case CCS811_RDSTATE_RESULT :
+      _rdok= i2cread_fetch(8,_rdbuf) && _rdok;
+      if( _appversion<0x2000 ) _rdbuf[4]= _rdstat; // Update STATUS field with correct STATUS
+      break;
+    case CCS811_RDSTATE_ERRORID : {
+      uint8_t err;
+      _rdok= i2cread_fetch(1,&err) && _rdok;
+      if( !_rdok ) _rderrstat |= CCS811_ERRSTAT_I2CFAIL; // Propagate I2C error
+      goto done;
     }
-    PRINTLN(F("ok"));
+  }
+  // Status and error management
+  _rderrstat= ccs811_errstat(_rdok,_rdbuf);
+  // Clear ERROR_ID if flags are set (in the same wake window)
+  if( _rderrstat & CCS811_ERRSTAT_HWERRORS ) {
+    _rdok= true;
+    rd_select(CCS811_ERROR_ID,CCS811_RDSTATE_ERRORID);
+    return false;
+  }
+done:
+  wake_down();
+  _rdstate= CCS811_RDSTATE_IDLE;
+  // Outputs
+  ccs811_output(_rdbuf,_rderrstat,eco2,etvoc,errstat,raw);
+  return true;
+}
 
-  // CCS811 back to sleep
+
+// Non-blocking read step: selects mailbox `regaddr` (as i2cread, only when not yet selected), continues in `state`.
+void CCS811::rd_select(int regaddr, uint8_t state) {
+  _rdstate= state;
+  _rdtime_us= micros();
+  if( _mailbox==regaddr ) {
+    _rdtime_us-= _i2cdelay_us; // No repeated START issued, so no need to wait
+  } else {
+    _rdok= i2cread_select(regaddr) && _rdok;
+  }
+}
+
+
+// Raw interface: RAW_DATA only =======================================================================================
+
+
+// Reads RAW_DATA (current in bits 15..10, ADC in bits 9..0) - no status is read. Returns false on I2C problems.
+// In CCS811_MODE_250MS, RAW_DATA is the only register that is updated (every 250ms).
+// When RAW_DATA is still selected (see i2cread), a read is a single I2C transaction of 3 bytes (slave address plus two data bytes).
+bool CCS811::read_raw(uint16_t * raw) {
+  uint8_t buf[2];
+  bool ok;
+  int_clear();
+  wake_up();
+    ok= i2cread(CCS811_RAW_DATA,2,buf);
   wake_down();
-  // Return success
+  *raw= ok ? buf[0]*256+buf[1] : 0; // As read(): 0 on I2C problems (the bus may have filled `buf` with 0xFF)
+  return ok;
+}
+
+
+// As read_raw(), but appends to `ring` (only when I2C is ok). Returns false on I2C problems.
+bool CCS811::read_raw(CCS811RawRing * ring) {
+  uint16_t raw;
+  bool ok= read_raw(&raw);
+  if( !ok ) return false;
+  ring->buf[ring->head]= raw;
+  ring->head= ring->head+1==ring->size ? 0 : ring->head+1;
+  if( ring->count<ring->size ) ring->count++;
   return true;
+}
 
-abort_begin:
-  // CCS811 back to sleep
+
+// Interrupt interface: nINT =========================================================================================
+
+
+// Returns true when the CCS811 signalled a new sample on nINT (since the last read). Always true when nINT is not connected.
+// The ISR only sets a flag; the pin level is checked too, in case the edge was missed (e.g. it came before begin()).
+bool CCS811::data_ready(void) {
+  if( _nint<0 ) return true;
+  if( _intslot>=0 && (ccs811_int_pending & (1<<_intslot)) ) return true;
+  return digitalRead(_nint)==LOW;
+}
+
+
+// Writes eCO2 (ppm) band boundaries to THRESHOLDS; next start() then signals nINT only when eCO2 changes band. Returns false on I2C problems.
+// The bands are low (below `lowmed`), medium and high (above `medhigh`); `hysteresis` (ppm) prevents toggling on a boundary.
+// Requires nINT (see constructor) and app mode (see begin). Write the thresholds before start(); datasheet defaults are 1500, 2500 and 50.
+bool CCS811::set_thresholds(uint16_t lowmed, uint16_t medhigh, uint8_t hysteresis) {
+  uint8_t buf[]= { HI(lowmed), LO(lowmed), HI(medhigh), LO(medhigh), hysteresis };
+  wake_up();
+  bool ok = i2cwrite(CCS811_THRESHOLDS,5,buf);
+  wake_down();
+  _thresh= ok;
+  return ok;
+}
+
+
+// Next start() signals nINT for every sample again.
+void CCS811::clear_thresholds(void) {
+  _thresh= false;
+}
+
+
+// Advanced interface: wake session ==================================================================================
+
+
+// Keeps nWAKE low until the matching wake_end(), so that calls in between share one wake-up. May be nested.
+// Each API call normally pulls nWAKE low, waits 50us, and pulls nWAKE high again. Calls in a wake session only pay that once:
+//   ccs811.wake_begin(); hw= ccs811.hardware_version(); app= ccs811.application_version(); ccs811.wake_end();
+// Or use the CCS811WakeSession class (ccs811.h) which does this for a scope.
+void CCS811::wake_begin(void) {
+  wake_up();
+}
+
+
+// Ends a wake_begin(); the last one pulls nWAKE high again.
+void CCS811::wake_end(void) {
   wake_down();
-  // Return failure
-  return false;
 }
 
 
@@ -551,14 +1288,68 @@ void CCS811::wake_init( void ) {
   if( _nwake>=0 ) pinMode(_nwake, OUTPUT);
 }
 
-// Wake up CCS811, i.e. pull nwake pin low.
+// Wake up CCS811, i.e. pull nwake pin low (unless already low due to an outer wake_up).
 void CCS811::wake_up( void) {
+  if( _wakecount++ > 0 ) return;
   if( _nwake>=0 ) { digitalWrite(_nwake, LOW); delayMicroseconds(CCS811_WAIT_AFTER_WAKE_US);  }
 }
 
-// CCS811 back to sleep, i.e. pull nwake pin high.
+// CCS811 back to sleep, i.e. pull nwake pin high (unless an outer wake_up is still active).
+// The datasheet does not say the CCS811 keeps its selected mailbox while asleep, so the cached one is dropped.
 void CCS811::wake_down( void) {
-  if( _nwake>=0 ) digitalWrite(_nwake, HIGH);
+  if( _wakecount==0 ) return; // Unbalanced call
+  if( --_wakecount > 0 ) return;
+  if( _nwake>=0 ) { digitalWrite(_nwake, HIGH); _mailbox= -1; }
+}
+
+
+// Helper interface: nint pin ========================================================================================
+
+
+// Configure nint pin for input and attach an interrupt to it. If nint<0 (in constructor), host performs no action.
+// When all slots are taken, data_ready() falls back to checking the pin level.
+void CCS811::int_init( void ) {
+  if( _nint<0 || _intslot>=0 ) return;
+  pinMode(_nint, INPUT_PULLUP); // nINT is open drain
+  for( int slot=0; slot<CCS811_INT_SLOTS; slot++ ) {
+    if( ccs811_int_used & (1<<slot) ) continue;
+    ccs811_int_used|= 1<<slot;
+    _intslot= slot;
+    int_clear();
+    attachInterrupt(digitalPinToInterrupt(_nint), ccs811_isrs[slot], FALLING);
+    return;
+  }
+  PRINTLN(F("ccs811: no interrupt slot free for nINT, polling its level"));
+}
+
+// Clear the data-ready flag set by the interrupt.
+void CCS811::int_clear( void ) {
+  if( _intslot<0 ) return;
+  noInterrupts();
+  ccs811_int_pending&= ~(1<<_intslot);
+  interrupts();
+}
+
+
+// Helper interface: adaptive timing ==================================================================================
+
+
+// Waits `wait_us` (for a command to complete), then reads `count` bytes of `regaddr` into `buf`. Returns false on I2C problems.
+// With adaptive timing, it instead polls until the read succeeds with all `mask` bits set in buf[0] (or it times out), 
+// and records how long that took in `*took_us`.
+bool CCS811::wait_read(unsigned long wait_us, int regaddr, int count, uint8_t * buf, uint8_t mask, unsigned long * took_us) {
+  if( !_adaptive ) {
+    ccs811_wait_us(wait_us);
+    return i2cread(regaddr,count,buf);
+  }
+  unsigned long start= micros();
+  ccs811_wait_us(wait_us/CCS811_ADAPTIVE_FIRST_DIV);
+  while( true ) {
+    bool ok= i2cread(regaddr,count,buf);
+    unsigned long took= micros()-start;
+    if( (ok && (buf[0]&mask)==mask) || took>=wait_us*CCS811_ADAPTIVE_TIMEOUT_MUL ) { *took_us= took; return ok; }
+    ccs811_wait_us(wait_us/CCS811_ADAPTIVE_POLL_DIV);
+  }
 }
 
 
@@ -567,22 +1358,72 @@ void CCS811::wake_down( void) {
 
 // Writes `count` from `buf` to register at address `regaddr` in the CCS811. Returns false on I2C problems.
 bool CCS811::i2cwrite(int regaddr, int count, const uint8_t * buf) {
-  Wire.beginTransmission(_slaveaddr);              // START, SLAVEADDR
-  Wire.write(regaddr);                             // Register address
-  for( int i=0; i<count; i++) Wire.write(buf[i]);  // Write bytes
-  int r= Wire.endTransmission(true);               // STOP
-  return r==0;
+  bool ok= _bus->write(_slaveaddr,regaddr,count,buf);
+  _mailbox= ok && count==0 ? regaddr : -1;         // A write with data may reset or switch the CCS811, a failed one may not have arrived (mailbox unknown)
+  return ok;
 }
 
 // Reads 'count` bytes from register at address `regaddr`, and stores them in `buf`. Returns false on I2C problems.
+// The CCS811 reads from the mailbox selected by the last write, so when `regaddr` is still selected,
+// the register address is not written again: the read is then a single START instead of a START and a repeated START.
 bool CCS811::i2cread(int regaddr, int count, uint8_t * buf) {
-  Wire.beginTransmission(_slaveaddr);              // START, SLAVEADDR
-  Wire.write(regaddr);                             // Register address
-  int wres= Wire.endTransmission(false);           // Repeated START
-  delayMicroseconds(_i2cdelay_us);                 // Wait
-  int rres=Wire.requestFrom(_slaveaddr,count);     // From CCS811, read bytes, STOP
-  for( int i=0; i<count; i++ ) buf[i]=Wire.read();
-  return (wres==0) && (rres==count);
+  if( _mailbox==regaddr ) return i2cread_fetch(count,buf); // Already selected: from CCS811, read bytes, STOP
+  bool ok= _bus->read(_slaveaddr,regaddr,count,buf,_i2cdelay_us);
+  _mailbox= ok ? regaddr : -1;
+  return ok;
+}
+
+// First half of i2cread: writes `regaddr` and issues a repeated START. Returns false on I2C problems.
+bool CCS811::i2cread_select(int regaddr) {
+  bool ok= _bus->select(_slaveaddr,regaddr);
+  _mailbox= ok ? regaddr : -1;
+  return ok;
+}
+
+// Second half of i2cread: reads `count` bytes into `buf`. Returns false on I2C problems.
+bool CCS811::i2cread_fetch(int count, uint8_t * buf) {
+  bool ok= _bus->fetch(_slaveaddr,count,buf);
+  if( !ok ) _mailbox= -1;                          // Not sure what the CCS811 received
+  return ok;
+}
+
+
+// I2C transport ======================================================================================================
+
+
+// select(), waits `delay_us`, fetch(). Override when the bus can do this in one go.
+bool CCS811Bus::read(int slaveaddr, int regaddr, int count, uint8_t * buf, int delay_us) {
+  bool wok= select(slaveaddr,regaddr);             // START, SLAVEADDR, register address, repeated START
+  delayMicroseconds(delay_us);                     // Wait
+  bool rok= fetch(slaveaddr,count,buf);            // From CCS811, read bytes, STOP
+  return wok && rok;
+}
+
+#ifndef CCS811_NO_WIRE
+// The caller still calls wire.begin().
+CCS811WireBus::CCS811WireBus(TwoWire & wire) : _wire(wire) {
+}
+
+bool CCS811WireBus::write(int slaveaddr, int regaddr, int count, const uint8_t * buf) {
+  _wire.beginTransmission(slaveaddr);              // START, SLAVEADDR
+  _wire.write(regaddr);                            // Register address
+  for( int i=0; i<count; i++) _wire.write(buf[i]); // Write bytes
+  int r= _wire.endTransmission(true);              // STOP
+  return r==0;
+}
+
+bool CCS811WireBus::select(int slaveaddr, int regaddr) {
+  _wire.beginTransmission(slaveaddr);              // START, SLAVEADDR
+  _wire.write(regaddr);                            // Register address
+  int wres= _wire.endTransmission(false);          // Repeated START
+  return wres==0;
+}
+
+bool CCS811WireBus::fetch(int slaveaddr, int count, uint8_t * buf) {
+  int rres= _wire.requestFrom(slaveaddr,count);    // From CCS811, read bytes, STOP
+  for( int i=0; i<count; i++ ) buf[i]= _wire.read();
+  return rres==count;
 }
+#endif
 
 
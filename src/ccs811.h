@@ -1,5 +1,44 @@
 /*
   ccs811.h - Library for the CCS811 digital gas sensor for monitoring indoor air quality from ams.
+  2026 oct 17  v50  The cached mailbox is dropped when nWAKE goes high
+  2026 oct 17  v49  CCS811Baseline retries a failed save (I2C or store) after CCS811BASELINE_RETRY_MS
+  2026 oct 17  v48  CCS811Manager: static_assert that the set_envdata() bit mask fits CCS811MANAGER_MAX
+  2026 oct 17  v47  CCS811Manager: static_assert that the flash() bit mask fits CCS811MANAGER_MAX
+  2026 oct 17  v46  CCS811Manager::poll() returns raw 0 when read_raw fails
+  2026 oct 17  v45  read_raw() returns 0 on I2C problems (as read())
+  2026 oct 17  v44  Adaptive flash polls STATUS before APP_DATA and APP_VERIFY instead of resending them
+  2026 oct 17  v43  read_begin() clears the result buffer, so a no-data read_poll() returns 0s as read()
+  2026 oct 17  v42  set_envdata_deadband: maxage_ms 0 means no maximum age
+  2026 oct 17  v42  Adaptive flash polls STATUS before APP_DATA and APP_VERIFY instead of resending them
+  2026 oct 17  v41  CCS811Baseline: begin(restore=false) after a warm resume; save() retries a failed read
+  2026 oct 17  v40  begin_warm() cold-starts an idle CCS811 and rewrites interrupt flags that differ from start()
+  2026 oct 17  v39  flash_image() skips only when STATUS has APP_VALID and no ERROR
+  2026 oct 17  v38  Blocking flash shares one wait loop (flash_run); read_begin refuses during a flash
+  2026 oct 17  v37  CCS811MuxBus::fetch after a select no longer switches the channel
+  2026 oct 17  v36  Added CCS811_NO_WIRE (no default Wire transport, e.g. for Linux)
+  2026 oct 17  v35  Include Arduino.h and Wire.h instead of forward declaring Stream and TwoWire
+  2026 oct 17  v34  Fixed the mailbox cache after a failed select (i2cwrite)
+  2026 oct 17  v33  Added ENV_DATA fan-out (CCS811Manager::set_envdata)
+  2026 oct 17  v32  Added change-suppressed ENV_DATA writes (set_envdata_deadband)
+  2026 oct 17  v31  Added integer (constexpr) ENV_DATA conversions and set_envdata_mCelsius_mpercRH
+  2026 oct 17  v30  Added baseline persistence (CCS811Baseline in ccs811baseline.h)
+  2026 oct 17  v29  Added warm start (begin_warm: resume a running CCS811 without reset)
+  2026 oct 17  v28  Added packed firmware images (CCS811Unpack in ccs811unpack.h)
+  2026 oct 17  v27  Added firmware image container (flash_image: validate, skip when installed)
+  2026 oct 17  v26  Flash from a reader callback or Stream (no image in PROGMEM)
+  2026 oct 17  v25  Parallel flash of several sensors (CCS811Manager::flash)
+  2026 oct 17  v24  Added adaptive timing (set_adaptive_timing, get_timing)
+  2026 oct 17  v23  Added non-blocking flash (flash_begin/flash_poll/flash_wait_us)
+  2026 oct 17  v22  Added CCS811Bus::switch_cost and get_bus (for CCS811Mux)
+  2026 oct 17  v21  Added get_mode (for CCS811Manager)
+  2026 oct 17  v20  Added pluggable I2C transport (CCS811Bus, CCS811WireBus)
+  2026 oct 17  v19  read() transfers only the ALG_RESULT_DATA prefix for its non-NULL args
+  2026 oct 17  v18  Fewer I2C transactions per read (no reselect of the selected mailbox, ERROR_ID cleared in the same wake)
+  2026 oct 17  v17  Added wake sessions (wake_begin/wake_end, CCS811WakeSession)
+  2026 oct 17  v16  Added CCS811_MODE_250MS and read_raw
+  2026 oct 17  v15  Added threshold interrupts (set_thresholds)
+  2026 oct 17  v14  Added nINT support (data_ready)
+  2026 oct 17  v13  Added non-blocking read (read_begin/read_poll)
   2021 jul 18  v12  Maarten Pennings  Added set_envdata_Celsius_percRH
   2021 jul 10  v11  Maarten Pennings  API comments improved
   2019 jan 22  v10  Maarten Pennings  Added F() on all strings, added get/set_baseline()
@@ -22,10 +61,14 @@
 
 
 #include <stdint.h>
+#include <Arduino.h> // Stream (on ArduinoCore-API cores arduino::Stream, so it can not be forward declared)
+#ifndef CCS811_NO_WIRE
+#include <Wire.h>    // TwoWire (on some cores a typedef, so it can not be forward declared)
+#endif
 
 
 // Version of this CCS811 driver
-#define CCS811_VERSION                     12 // Also in library.properties and revision history in .h/.cpp
+#define CCS811_VERSION                     50 // Also in library.properties and revision history in .h/.cpp
 
 
 // I2C slave address for ADDR 0 respectively 1
@@ -38,6 +81,7 @@
 #define CCS811_MODE_1SEC                   1
 #define CCS811_MODE_10SEC                  2
 #define CCS811_MODE_60SEC                  3
+#define CCS811_MODE_250MS                  4 // Only RAW_DATA is updated (use read_raw), ALG_RESULT_DATA is not
 
 
 // The flags for errstat in ccs811_read()
@@ -64,39 +108,212 @@
 #define CCS811_ERRSTAT_OK_NODATA           ( CCS811_ERRSTAT_APP_VALID | CCS811_ERRSTAT_FW_MODE )
 
 
+// A ring buffer, owned by the caller, filled by read_raw(CCS811RawRing*)
+struct CCS811RawRing {
+  uint16_t * buf;                                                             // Storage for `size` raw samples
+  uint8_t    size;                                                            // Number of entries in `buf`
+  uint8_t    head;                                                            // Index in `buf` where the next sample is stored
+  uint8_t    count;                                                           // Number of samples in `buf` (at most `size`, oldest are overwritten)
+};
+
+
+// The I2C transport of a CCS811. Subclass it for e.g. a software I2C, a mux channel or Linux i2c-dev.
+class CCS811Bus {
+  public:
+    virtual ~CCS811Bus() {}
+    virtual bool write(int slaveaddr, int regaddr, int count, const uint8_t * buf) = 0; // START, slave address, register address, `count` bytes from `buf`, STOP. Returns false on I2C problems.
+    virtual bool select(int slaveaddr, int regaddr) = 0;                      // START, slave address, register address, but no STOP (a read follows). Returns false on I2C problems.
+    virtual bool fetch(int slaveaddr, int count, uint8_t * buf) = 0;          // (Repeated) START, slave address, reads `count` bytes into `buf`, STOP. Returns false on I2C problems.
+    virtual bool read(int slaveaddr, int regaddr, int count, uint8_t * buf, int delay_us); // select(), waits `delay_us`, fetch(). Override when the bus can do this in one go.
+    virtual int  switch_cost(void) { return 0; }                              // Extra writes needed before the next transfer (e.g. a mux channel select); schedulers prefer 0.
+};
+
+
+// Timings observed with adaptive timing (see set_adaptive_timing), in us.
+struct CCS811Timing {
+  unsigned long reset_us;                                                     // SW_RESET until ready (last begin or flash)
+  unsigned long appstart_us;                                                  // APP_START until in app mode (last begin)
+  unsigned long erase_us;                                                     // APP_ERASE until erased (last flash)
+  unsigned long verify_us;                                                    // APP_VERIFY until verified (last flash)
+  unsigned long appdata_us;                                                   // APP_DATA until ready for the next block (maximum over all blocks)
+};
+
+
+class CCS811;
+// Called by the non-blocking flash after each block written: `done` of `size` image bytes are written to `ccs811`.
+typedef void (*CCS811FlashProgress)(CCS811 * ccs811, int done, int size);
+
+
+// Source of a firmware image that is not in PROGMEM (e.g. a file on SD, a serial upload, a network download).
+// Copies `len` bytes of the image, starting at `pos`, to `buf`. Returns the number of bytes copied (less than `len` fails the flash).
+// The flash asks for the blocks in order (`pos` 0, 8, 16, ...), each once, so a sequential source may ignore `pos`.
+typedef int (*CCS811FlashReader)(void * context, uint8_t * buf, int pos, int len);
+
+
+// The results of flash_poll()
+#define CCS811_FLASH_FAILED                (-1) // Flash failed (or no flash in progress)
+#define CCS811_FLASH_DONE                  0    // Flash completed successfully
+#define CCS811_FLASH_BUSY                  1    // Flash in progress, call flash_poll() again
+
+
+// Firmware image container: a header of CCS811_IMAGE_HEADER_SIZE bytes, followed by the image (see flash_image).
+// Header: 'C','8','1','1', format, flags, app version (2), image size (2), CRC-16/CCITT of the image (2); big endian.
+#define CCS811_IMAGE_HEADER_SIZE           12
+#define CCS811_IMAGE_FORMAT                1    // The header format of this driver
+// The results of flash_image()
+#define CCS811_IMAGE_INVALID               (-2) // Image rejected (bad header, size or checksum), the CCS811 is not touched
+#define CCS811_IMAGE_FAILED                (-1) // Flash failed
+#define CCS811_IMAGE_FLASHED               0    // Image flashed successfully
+#define CCS811_IMAGE_SKIPPED               1    // The CCS811 already has a valid app (no ERROR) of the version of the image, not flashed
+
+
+#ifndef CCS811_NO_WIRE
+// The default transport: an Arduino TwoWire (Wire, or e.g. Wire1 for a second hardware bus).
+// Define CCS811_NO_WIRE (for all files of the library) on platforms without Wire, e.g. Linux; then every CCS811 needs a bus.
+class CCS811WireBus : public CCS811Bus {
+  public:
+    CCS811WireBus(TwoWire & wire);                                            // The caller still calls wire.begin().
+    virtual bool write(int slaveaddr, int regaddr, int count, const uint8_t * buf);
+    virtual bool select(int slaveaddr, int regaddr);
+    virtual bool fetch(int slaveaddr, int count, uint8_t * buf);
+  private:
+    TwoWire & _wire;
+};
+#endif
+
+
 class CCS811 {
   public: // Main interface
-    CCS811(int nwake=-1, int slaveaddr=CCS811_SLAVEADDR_0);                   // Pin number connected to nWAKE (nWAKE can also be bound to GND, then pass -1), slave address (5A or 5B)
+    CCS811(int nwake=-1, int slaveaddr=CCS811_SLAVEADDR_0, int nint=-1, CCS811Bus * bus=0); // Pin number connected to nWAKE (nWAKE can also be bound to GND, then pass -1), slave address (5A or 5B), pin number connected to nINT (or -1), transport (0 for Wire, required with CCS811_NO_WIRE)
+    ~CCS811();                                                                // Releases the interrupt attached to nINT (if any).
     bool begin( void );                                                       // Reset the CCS811, switch to app mode and check HW_ID. Returns false on problems.
-    bool start( int mode );                                                   // Switch CCS811 to `mode`, use constants CCS811_MODE_XXX. Returns false on I2C problems.
-    void read( uint16_t*eco2, uint16_t*etvoc, uint16_t*errstat,uint16_t*raw); // Get measurement results from the CCS811 (all args may be NULL), check status via errstat, e.g. ccs811_errstat(errstat)
+    bool begin_warm( void );                                                  // As begin(), but resumes a CCS811 that already measures (no reset; get_mode() returns its mode, interrupts as start() sets them). Returns false on problems.
+    bool start( int mode );                                                   // Switch CCS811 to `mode`, use constants CCS811_MODE_XXX. Enables the data-ready interrupt when nINT is connected. Returns false on I2C problems.
+    void read( uint16_t*eco2, uint16_t*etvoc, uint16_t*errstat,uint16_t*raw); // Get measurement results from the CCS811 (all args may be NULL, only the bytes for the others are read), check status via errstat, e.g. ccs811_errstat(errstat)
     const char * errstat_str(uint16_t errstat);                               // Returns a string version of an errstat. Note, each call, this string is updated.
   public: // Extra interface
     int  hardware_version(void);                                              // Gets version of the CCS811 hardware (returns -1 on I2C failure).
     int  bootloader_version(void);                                            // Gets version of the CCS811 bootloader (returns -1 on I2C failure).
     int  application_version(void);                                           // Gets version of the CCS811 application (returns -1 on I2C failure).
     int  get_errorid(void);                                                   // Gets the ERROR_ID [same as 'err' part of 'errstat' in 'read'] (returns -1 on I2C failure).
+    int  get_mode(void);                                                      // Returns the mode of the last successful start() since begin() (CCS811_MODE_IDLE if none).
+    CCS811Bus * get_bus(void);                                                // Returns the I2C transport of this CCS811.
+    void set_adaptive_timing(bool adaptive);                                  // When true, begin() and flash() poll the CCS811 until ready instead of waiting the fixed worst case (bounded). Relies on a busy CCS811 not ACKing (not verified on hardware).
+    void get_timing(CCS811Timing * timing);                                   // Copies the timings observed with adaptive timing to `timing` (0 for a step not yet observed).
     bool set_envdata(uint16_t t, uint16_t h);                                 // Writes t and h to ENV_DATA (see datasheet for CCS811 format). Returns false on I2C problems.
     bool set_envdata210(uint16_t t, uint16_t h);                              // Writes t and h (in ENS210 format) to ENV_DATA. Returns false on I2C problems.
     bool set_envdata_Celsius_percRH(float t, float h);                        // Writes t (in Celsius) and h (in percentage RH) to ENV_DATA. Returns false on I2C problems.
+    bool set_envdata_mCelsius_mpercRH(int32_t t, int32_t h);                  // Writes t (in milli Celsius) and h (in milli percentage RH) to ENV_DATA, without floats. Returns false on I2C problems.
     bool get_baseline(uint16_t *baseline);                                    // Reads (encoded) baseline from BASELINE. Returns false on I2C problems. Get it, just before power down (but only when sensor was on at least 20min) - see CCS811_AN000370.
     bool set_baseline(uint16_t baseline);                                     // Writes (encoded) baseline to BASELINE. Returns false on I2C problems. Set it, after power up (and after 20min).
-    bool flash(const uint8_t * image, int size);                              // Flashes the firmware of the CCS811 with size bytes from image - image _must_ be in PROGMEM.
+    bool flash(const uint8_t * image, int size);                              // Flashes the firmware of the CCS811 with size bytes from image - image _must_ be in PROGMEM. Blocks for about 30s (see flash_begin for non-blocking).
+    bool flash(CCS811FlashReader reader, void * context, int size);           // As flash(), but the `size` image bytes come from `reader` (called with `context`), one 8 byte block at a time.
+    bool flash(Stream & stream, int size);                                    // As flash(), but reads the `size` image bytes from `stream` (e.g. an SD File or Serial), one 8 byte block at a time.
+  public: // Conversion interface: to the ENV_DATA format (1/512 units, temperature offset by 25C), integer only, rounded, clipped to 0..65535
+    static constexpr uint16_t envdata_t_mCelsius(int32_t t) { return t<-25000 ? 0 : t>=102999 ? 65535 : (uint16_t)(((t+25000)*64+62)/125); } // Temperature `t` in milli Celsius, e.g. 23500 gives 0x6100.
+    static constexpr uint16_t envdata_h_mpercRH(int32_t h)  { return h<0 ? 0 : h>=127999 ? 65535 : (uint16_t)((h*64+62)/125); } // Humidity `h` in milli percentage RH, e.g. 48500 gives 0x6100.
+    static constexpr uint16_t envdata_t_ens210(uint16_t t)  { return t<15882 ? 0 : t>24073 ? 65535 : (uint16_t)(t*8L-127053); } // ENS210 raw temperature `t` (1/64 Kelvin); 8*t-(273.15-25)*8*64 (ENS210 humidity needs no conversion).
+  public: // Compensation interface: change-suppressed ENV_DATA writes
+    void set_envdata_deadband(uint16_t t, uint16_t h, unsigned long maxage_ms); // set_envdata (and variants) skip the write when t and h (ENV_DATA units) are within t resp. h of the last write, and it is younger than maxage_ms (0: no maximum age). All 0 (default) writes always.
+    uint32_t get_envdata_suppressed(void);                                    // Returns the number of ENV_DATA writes skipped by the dead-band (since construction).
+  public: // Asynchronous interface: non-blocking read
+    bool read_begin(void);                                                    // Starts a read that never waits; finish it by calling read_poll() (e.g. from loop()). Returns false when a read or flash is in progress.
+    bool read_poll(uint16_t*eco2, uint16_t*etvoc, uint16_t*errstat, uint16_t*raw); // Advances the read started by read_begin(). Returns false while busy, true when done; then args are set as by read().
+  public: // Asynchronous interface: non-blocking flash
+    bool flash_begin(const uint8_t * image, int size, CCS811FlashProgress progress=0); // Starts flashing `size` bytes of `image` (PROGMEM); advance it with flash_poll(). Returns false when a flash or read is in progress.
+    bool flash_begin(CCS811FlashReader reader, void * context, int size, CCS811FlashProgress progress=0); // As flash_begin(), but the image bytes come from `reader` (called with `context`).
+    int  flash_poll(void);                                                    // Does the next step (at most one I2C transaction) when its wait is over. Returns CCS811_FLASH_BUSY, CCS811_FLASH_DONE or CCS811_FLASH_FAILED.
+    unsigned long flash_wait_us(void);                                        // Time in us until flash_poll() can do its next step (0 when it can do it now).
+  public: // Image interface: flash a firmware image container (only when valid, and not yet installed)
+    int  flash_image(const uint8_t * header, const uint8_t * image, bool force=false); // Flashes the container with `header` and `image` (both PROGMEM). Returns CCS811_IMAGE_XXX; flashes an installed version only when `force`.
+    int  flash_image(CCS811FlashReader reader, void * context, bool force=false); // As flash_image(), but the container (header at pos 0) comes from `reader`; it is read twice (validation, flash).
+  public: // Raw interface: RAW_DATA only (e.g. for CCS811_MODE_250MS)
+    bool read_raw(uint16_t * raw);                                            // Reads RAW_DATA (current in bits 15..10, ADC in bits 9..0) - no status is read. Returns false on I2C problems.
+    bool read_raw(CCS811RawRing * ring);                                      // As read_raw(), but appends to `ring` (only when I2C is ok). Returns false on I2C problems.
+  public: // Interrupt interface: nINT
+    bool data_ready(void);                                                    // Returns true when the CCS811 signalled a new sample on nINT (since the last read). Always true when nINT is not connected.
+    bool set_thresholds(uint16_t lowmed, uint16_t medhigh, uint8_t hysteresis=50); // Writes eCO2 (ppm) band boundaries to THRESHOLDS; next start() then signals nINT only when eCO2 changes band. Returns false on I2C problems.
+    void clear_thresholds(void);                                              // Next start() signals nINT for every sample again.
+  public: // Advanced interface: wake session
+    void wake_begin(void);                                                    // Keeps nWAKE low until the matching wake_end(), so that calls in between share one wake-up. May be nested.
+    void wake_end(void);                                                      // Ends a wake_begin(); the last one pulls nWAKE high again.
   public: // Advanced interface: i2cdelay
     void set_i2cdelay(int us);                                                // Delay before a repeated start - needed for e.g. ESP8266 because it doesn't handle I2C clock stretch correctly.
     int  get_i2cdelay(void);                                                  // Get current repeated start delay.
   protected: // Helper interface: nwake pin
     void wake_init(void);                                                     // Configure nwake pin for output. If nwake<0 (in constructor), then CCS811 nWAKE pin is assumed not connected to a pin of the host, so host will perform no action.
-    void wake_up(void);                                                       // Wake up CCS811, i.e. pull nwake pin low.
-    void wake_down(void);                                                     // CCS811 back to sleep, i.e. pull nwake pin high.
+    void wake_up(void);                                                       // Wake up CCS811, i.e. pull nwake pin low (unless already low due to an outer wake_up).
+    void wake_down(void);                                                     // CCS811 back to sleep, i.e. pull nwake pin high (unless an outer wake_up is still active).
+  protected: // Helper interface: nint pin
+    void int_init(void);                                                      // Configure nint pin for input and attach an interrupt to it. If nint<0 (in constructor), host performs no action.
+    void int_clear(void);                                                     // Clear the data-ready flag set by the interrupt.
   protected: // Helper interface: i2c wrapper
     bool i2cwrite(int regaddr, int count, const uint8_t * buf);               // Writes `count` from `buf` to register at address `regaddr` in the CCS811. Returns false on I2C problems.
-    bool i2cread (int regaddr, int count, uint8_t * buf);                     // Reads 'count` bytes from register at address `regaddr`, and stores them in `buf`. Returns false on I2C problems.
+    bool i2cread (int regaddr, int count, uint8_t * buf);                     // Reads 'count` bytes from register at address `regaddr`, and stores them in `buf`. Skips the select when `regaddr` is still selected. Returns false on I2C problems.
+    bool i2cread_select(int regaddr);                                         // First half of i2cread: writes `regaddr` and issues a repeated START. Returns false on I2C problems.
+    bool i2cread_fetch(int count, uint8_t * buf);                             // Second half of i2cread: reads `count` bytes into `buf`. Returns false on I2C problems.
+  private: // Helper interface: measurement mode
+    uint8_t meas_mode_for(int mode);                                          // The MEAS_MODE value start(`mode`) writes (drive mode and interrupt flags).
+  private: // Helper interface: non-blocking read
+    void rd_select(int regaddr, uint8_t state);                               // Selects `regaddr` (unless already selected) and continues the non-blocking read in `state`.
+  private: // Helper interface: non-blocking flash
+    bool flash_run(void);                                                     // Runs the begun flash to its end, waiting where flash_poll() would return. Returns true when flashed.
+    void flash_next(uint8_t state, unsigned long wait_us);                    // Next step of the flash is `state`, after waiting `wait_us`.
+    bool flash_retry(void);                                                   // With adaptive timing, retries the current step later; returns false on timeout.
+    void flash_took(unsigned long * took_us, bool max);                       // With adaptive timing, records how long the previous step took.
+  private: // Helper interface: adaptive timing
+    bool wait_read(unsigned long wait_us, int regaddr, int count, uint8_t * buf, uint8_t mask, unsigned long * took_us); // Waits (or polls) for the CCS811, then reads `regaddr`.
   private:
     int  _nwake;                                                              // Pin number for nWAKE pin (or -1).
+    uint8_t _wakecount;                                                       // Nesting depth of wake_up() calls; nWAKE is low when non-zero.
     int  _slaveaddr;                                                          // I2C slave address of the CCS811.
+    CCS811Bus * _bus;                                                         // The I2C transport to the CCS811.
+    int  _nint;                                                               // Pin number for nINT pin (or -1).
+    int  _intslot;                                                            // Interrupt slot (ISR) assigned to the nINT pin (or -1).
+    bool _thresh;                                                             // THRESHOLDS written, start() enables threshold interrupts.
     int  _i2cdelay_us;                                                        // Delay in us just before an I2C repeated start condition.
     int  _appversion;                                                         // Version of the app firmware inside the CCS811 (for workarounds).
+    uint8_t _mode;                                                            // Mode of the last successful start() (CCS811_MODE_XXX).
+    int  _mailbox;                                                            // Mailbox selected by the last I2C write (or -1 when unknown).
+    uint8_t  _rdstate;                                                        // State of the non-blocking read (CCS811_RDSTATE_XXX in ccs811.cpp).
+    unsigned long _rdtime_us;                                                 // Time (micros) the non-blocking read entered its current state.
+    bool     _rdok;                                                           // I2C status of the non-blocking read so far.
+    uint8_t  _rdstat;                                                         // STATUS read by the non-blocking read (pre 2.0.0 firmware).
+    uint16_t _rderrstat;                                                      // The errstat of the non-blocking read.
+    uint8_t  _rdbuf[8];                                                       // The ALG_RESULT_DATA of the non-blocking read.
+    uint8_t  _flstate;                                                        // State of the non-blocking flash (CCS811_FLSTATE_XXX in ccs811.cpp).
+    const uint8_t * _flimage;                                                 // The image being flashed (PROGMEM), when there is no _flreader.
+    CCS811FlashReader _flreader;                                              // The source of the image being flashed (or NULL for _flimage).
+    void *   _flcontext;                                                      // Context passed to _flreader.
+    int      _flsize;                                                         // Size of the image.
+    int      _flpos;                                                          // Number of image bytes written so far.
+    unsigned long _fltime_us;                                                 // Time (micros) the non-blocking flash entered its current state.
+    unsigned long _flwait_us;                                                 // Wait (us) before the current state may do its step.
+    CCS811FlashProgress _flprogress;                                          // Progress callback (or NULL).
+    unsigned long _flstep_us;                                                 // Time (micros) the current step's wait started (for adaptive timing).
+    unsigned long _flfixed_us;                                                // The fixed wait of the current step (adaptive timing polls within twice that).
+    bool     _adaptive;                                                       // Adaptive timing enabled.
+    uint16_t _envt;                                                           // Temperature of the last ENV_DATA write (valid when _envvalid).
+    uint16_t _envh;                                                           // Humidity of the last ENV_DATA write (valid when _envvalid).
+    bool     _envvalid;                                                       // ENV_DATA was written (since begin).
+    unsigned long _envtime_ms;                                                // Time (millis) of the last ENV_DATA write.
+    uint16_t _envband_t;                                                      // Dead-band of the temperature (ENV_DATA units).
+    uint16_t _envband_h;                                                      // Dead-band of the humidity (ENV_DATA units).
+    unsigned long _envmaxage_ms;                                              // Maximum age of the last ENV_DATA write, before the dead-band no longer applies (0 for no maximum).
+    bool     _envdeadband;                                                    // Dead-band enabled (not all of _envband_t, _envband_h and _envmaxage_ms are 0).
+    uint32_t _envsuppressed;                                                  // Number of ENV_DATA writes skipped.
+    CCS811Timing _timing;                                                     // Timings observed with adaptive timing.
+};
+
+
+// Wake session: keeps nWAKE of `ccs811` low for the lifetime of this object, e.g.
+//   { CCS811WakeSession session(ccs811); ccs811.hardware_version(); ccs811.application_version(); }
+class CCS811WakeSession {
+  public:
+    CCS811WakeSession(CCS811 & ccs811) : _ccs811(ccs811) { _ccs811.wake_begin(); }
+    ~CCS811WakeSession() { _ccs811.wake_end(); }
+  private:
+    CCS811 & _ccs811;
 };
 
 
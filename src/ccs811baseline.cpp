@@ -0,0 +1,140 @@
+/*
+  ccs811baseline.cpp - Keeps the BASELINE of a CCS811 across power cycles, following ams AN000370:
+  save it (only after the sensor ran long enough) on a schedule, and restore it after power-up (once warmed up).
+  The baseline is stored wear levelled and with a checksum, via a pluggable store (EEPROM, NVS, a file).
+  2026 oct 17  v3  A failed save (I2C or store) is retried after CCS811BASELINE_RETRY_MS
+  2026 oct 17  v2  begin(restore); save() retries after a failed read
+  2026 oct 17  v1  Created
+*/
+
+
+#include <Arduino.h>
+#include "ccs811baseline.h"
+
+
+// Store slots ========================================================================================================
+
+
+// CRC-8 (polynomial 0x31, start with 0xFF) of `count` bytes in `buf`
+static uint8_t ccs811baseline_crc8(const uint8_t * buf, int count) {
+  uint8_t crc= 0xFF;
+  for( int i=0; i<count; i++ ) {
+    crc^= buf[i];
+    for( int b=0; b<8; b++ ) crc= crc&0x80 ? (crc<<1)^0x31 : crc<<1;
+  }
+  return crc;
+}
+
+
+// Reads `slot`; returns false when it does not hold a valid baseline (e.g. erased)
+bool CCS811Baseline::slot_read(int slot, uint16_t * seq, uint16_t * baseline) {
+  uint8_t buf[CCS811BASELINE_SLOT_SIZE];
+  if( !_store->read(slot*CCS811BASELINE_SLOT_SIZE,buf,CCS811BASELINE_SLOT_SIZE) ) return false;
+  if( ccs811baseline_crc8(buf,4)!=buf[4] ) return false;
+  *seq= (buf[0]<<8) + buf[1];
+  *baseline= (buf[2]<<8) + buf[3];
+  return true;
+}
+
+
+// Baseline manager ===================================================================================================
+
+
+// The sensor (begin() and start() are still called by the caller) and the store.
+CCS811Baseline::CCS811Baseline(CCS811 * ccs811, CCS811Store * store) {
+  _ccs811= ccs811;
+  _store= store;
+  _warmup_ms= CCS811BASELINE_WARMUP_MS;
+  _period_ms= CCS811BASELINE_PERIOD_MS;
+  _begin_ms= 0;
+  _save_ms= 0;
+  _retry= false;
+  _restored= false;
+  _newest= -1;
+  _seq= 0;
+  _baseline= 0;
+  _writes= 0;
+}
+
+
+// Changes the warm-up time (before restore or save) and the save period.
+void CCS811Baseline::set_times(unsigned long warmup_ms, unsigned long period_ms) {
+  _warmup_ms= warmup_ms;
+  _period_ms= period_ms;
+}
+
+
+// Call after the CCS811 started: scans the store for the newest valid slot and starts the warm-up timer.
+// The sequence numbers wrap, so "newer" is a signed 16 bit difference.
+// Pass `restore` false when begin_warm() resumed a running CCS811: its baseline is newer than the stored one, so poll() only saves.
+void CCS811Baseline::begin(bool restore) {
+  int slots= _store->size()/CCS811BASELINE_SLOT_SIZE;
+  _newest= -1;
+  for( int slot=0; slot<slots; slot++ ) {
+    uint16_t seq, baseline;
+    if( !slot_read(slot,&seq,&baseline) ) continue;
+    if( _newest<0 || (int16_t)(seq-_seq)>0 ) { _newest= slot; _seq= seq; _baseline= baseline; }
+  }
+  _begin_ms= millis();
+  _save_ms= _begin_ms;
+  _retry= false;
+  _restored= !restore;
+}
+
+
+// Call from loop(): once the warm-up passed, writes the stored baseline (if any) to the CCS811; after that, saves it every period.
+// Returns CCS811BASELINE_XXX; does I2C only when it restores or saves.
+int CCS811Baseline::poll(void) {
+  unsigned long now= millis();
+  if( !_restored ) {
+    if( now-_begin_ms<_warmup_ms ) return CCS811BASELINE_NONE;
+    _restored= true;
+    _save_ms= now;
+    if( _newest<0 ) return CCS811BASELINE_NONE; // Nothing stored yet, first save after a period
+    return _ccs811->set_baseline(_baseline) ? CCS811BASELINE_RESTORED : CCS811BASELINE_FAILED;
+  }
+  unsigned long wait_ms= _retry && CCS811BASELINE_RETRY_MS<_period_ms ? CCS811BASELINE_RETRY_MS : _period_ms;
+  if( now-_save_ms<wait_ms ) return CCS811BASELINE_NONE;
+  return save() ? CCS811BASELINE_SAVED : CCS811BASELINE_FAILED;
+}
+
+
+// Saves the baseline now (e.g. before power-down), if the sensor ran longer than the warm-up. Returns false on problems or when too early.
+// An unchanged baseline is not written again; otherwise it goes to the slot after the newest (wear levelling).
+// After a failed save (I2C or store problems), poll() tries again after CCS811BASELINE_RETRY_MS instead of a full period.
+bool CCS811Baseline::save(void) {
+  unsigned long now= millis();
+  if( now-_begin_ms<_warmup_ms ) return false;
+  _save_ms= now;
+  _retry= true; // Until saved
+  uint16_t baseline;
+  if( !_ccs811->get_baseline(&baseline) ) return false;
+  if( _newest>=0 && baseline==_baseline ) { _retry= false; return true; }
+  int slots= _store->size()/CCS811BASELINE_SLOT_SIZE;
+  if( slots==0 ) return false;
+  int slot= _newest<0 ? 0 : (_newest+1)%slots;
+  uint16_t seq= _seq+1;
+  uint8_t buf[CCS811BASELINE_SLOT_SIZE]= { (uint8_t)(seq>>8), (uint8_t)(seq&0xFF), (uint8_t)(baseline>>8), (uint8_t)(baseline&0xFF), 0 };
+  buf[4]= ccs811baseline_crc8(buf,4);
+  if( !_store->write(slot*CCS811BASELINE_SLOT_SIZE,buf,CCS811BASELINE_SLOT_SIZE) || !_store->commit() ) return false;
+  _retry= false;
+  _writes++;
+  _newest= slot;
+  _seq= seq;
+  _baseline= baseline;
+  return true;
+}
+
+
+// Gets the newest valid baseline in the store. Returns false when there is none.
+bool CCS811Baseline::stored(uint16_t * baseline) {
+  if( _newest<0 ) return false;
+  *baseline= _baseline;
+  return true;
+}
+
+
+// Returns the number of slots written (since construction).
+uint32_t CCS811Baseline::writes(void) {
+  return _writes;
+}
@@ -0,0 +1,73 @@
+/*
+  ccs811baseline.h - Keeps the BASELINE of a CCS811 across power cycles, following ams AN000370:
+  save it (only after the sensor ran long enough) on a schedule, and restore it after power-up (once warmed up).
+  The baseline is stored wear levelled and with a checksum, via a pluggable store (EEPROM, NVS, a file).
+  2026 oct 17  v3  A failed save (I2C or store) is retried after CCS811BASELINE_RETRY_MS
+  2026 oct 17  v2  begin(restore); save() retries after a failed read
+  2026 oct 17  v1  Created
+*/
+#ifndef _CCS811BASELINE_H_
+#define _CCS811BASELINE_H_
+
+
+#include <stdint.h>
+#include "ccs811.h"
+
+
+// Default times (see set_times): the sensor must run this long before its baseline is restored or saved (AN000370: 20 minutes)
+#define CCS811BASELINE_WARMUP_MS           (20UL*60*1000)
+// ... and the baseline is saved this often (AN000370: daily in the first 500 hours, weekly afterwards)
+#define CCS811BASELINE_PERIOD_MS           (24UL*60*60*1000)
+// ... but after a failed save (I2C or store problems) it is retried this much later
+#define CCS811BASELINE_RETRY_MS            (60UL*1000)
+
+
+// Bytes per slot in the store: sequence number (2), baseline (2), CRC-8 (1)
+#define CCS811BASELINE_SLOT_SIZE           5
+
+
+// The results of poll()
+#define CCS811BASELINE_NONE                0    // Nothing done (no I2C)
+#define CCS811BASELINE_RESTORED            1    // The stored baseline was written to the CCS811
+#define CCS811BASELINE_SAVED               2    // The baseline of the CCS811 was stored (or was already stored)
+#define CCS811BASELINE_FAILED              (-1) // I2C or store problems
+
+
+// Non-volatile storage for the baseline manager, e.g. a range of the EEPROM, an NVS blob, or a file.
+class CCS811Store {
+  public:
+    virtual int  size(void) = 0;                                              // Number of bytes in the store (slots are CCS811BASELINE_SLOT_SIZE bytes, so e.g. 60 bytes give 12 slots).
+    virtual bool read(int addr, uint8_t * buf, int count) = 0;                // Reads `count` bytes at `addr` into `buf`. Returns false on problems.
+    virtual bool write(int addr, const uint8_t * buf, int count) = 0;         // Writes `count` bytes from `buf` at `addr`. Returns false on problems.
+    virtual bool commit(void) { return true; }                                // Makes the writes durable (e.g. EEPROM.commit on ESP). Returns false on problems.
+};
+
+
+// Restores and saves the baseline of one CCS811. Each save goes to the next slot (wear levelling); the newest valid slot wins.
+class CCS811Baseline {
+  public:
+    CCS811Baseline(CCS811 * ccs811, CCS811Store * store);                     // The sensor (begin() and start() are still called by the caller) and the store.
+    void set_times(unsigned long warmup_ms, unsigned long period_ms);         // Changes the warm-up time (before restore or save) and the save period.
+    void begin(bool restore=true);                                            // Call after the CCS811 started: scans the store and starts the warm-up timer. Pass false after a resumed begin_warm() (the CCS811 baseline is newer).
+    int  poll(void);                                                          // Call from loop(): restores after the warm-up, then saves every period. Returns CCS811BASELINE_XXX.
+    bool save(void);                                                          // Saves the baseline now (e.g. before power-down), if the sensor ran longer than the warm-up. Returns false on problems or when too early.
+    bool stored(uint16_t * baseline);                                         // Gets the newest valid baseline in the store. Returns false when there is none.
+    uint32_t writes(void);                                                    // Returns the number of slots written (since construction).
+  private:
+    bool     slot_read(int slot, uint16_t * seq, uint16_t * baseline);
+    CCS811 * _ccs811;
+    CCS811Store * _store;
+    unsigned long _warmup_ms;
+    unsigned long _period_ms;
+    unsigned long _begin_ms;                                                  // Time (millis) of begin()
+    unsigned long _save_ms;                                                   // Time (millis) of the last restore or save (attempt)
+    bool     _retry;                                                          // The last save failed, next one after CCS811BASELINE_RETRY_MS
+    bool     _restored;                                                       // Warm-up passed, stored baseline (if any) written
+    int      _newest;                                                         // Slot with the newest valid baseline (-1 when none)
+    uint16_t _seq;                                                            // Sequence number of _newest
+    uint16_t _baseline;                                                       // Baseline in _newest
+    uint32_t _writes;
+};
+
+
+#endif
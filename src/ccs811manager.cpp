@@ -0,0 +1,181 @@
+/*
+  ccs811manager.cpp - Schedules the reads of several CCS811 sensors, so that each is only read when its next sample is due.
+  2026 oct 17  v7  static_assert on CCS811MANAGER_MAX for the set_envdata() bit mask
+  2026 oct 17  v6  static_assert on CCS811MANAGER_MAX for the flash() bit mask
+  2026 oct 17  v5  poll() returns raw 0 when read_raw fails
+  2026 oct 17  v4  Added ENV_DATA fan-out (one T/H source to all sensors)
+  2026 oct 17  v3  Added parallel flash
+  2026 oct 17  v2  Reads are grouped by bus (mux channel)
+  2026 oct 17  v1  Created
+*/
+
+
+#include <Arduino.h>
+#include "ccs811manager.h"
+
+
+// Returns the sample period in ms of `mode` (0 for CCS811_MODE_IDLE)
+static unsigned long ccs811manager_period_ms(int mode) {
+  switch( mode ) {
+    case CCS811_MODE_1SEC  : return 1000;
+    case CCS811_MODE_10SEC : return 10000;
+    case CCS811_MODE_60SEC : return 60000;
+    case CCS811_MODE_250MS : return 250;
+  }
+  return 0;
+}
+
+
+CCS811Manager::CCS811Manager() {
+  _count= 0;
+}
+
+
+// Adds a sensor (it may be on any bus or address, begin() and start() are still called by the caller). Returns its index, or -1 when full.
+int CCS811Manager::add(CCS811 * ccs811) {
+  if( _count>=CCS811MANAGER_MAX ) return -1;
+  _sensors[_count]= ccs811;
+  _mode[_count]= CCS811_MODE_IDLE;
+  _due_ms[_count]= 0;
+  return _count++;
+}
+
+
+// Returns the number of sensors added.
+int CCS811Manager::count(void) {
+  return _count;
+}
+
+
+// Returns the sensor with `index` (or NULL).
+CCS811 * CCS811Manager::sensor(int index) {
+  if( index<0 || index>=_count ) return 0;
+  return _sensors[index];
+}
+
+
+// Reads the (most overdue) sensor whose sample is due. Returns its index, args set as by read(); or -1 when none is due (no I2C).
+// A sensor is due one sample period after its start() (as seen by the manager) or after its previous sample.
+// Due sensors that need no bus switch (e.g. on the mux channel that is selected) go first, so reads are grouped by channel.
+// When its nINT is connected, it is also only due when data_ready(). Sensors in CCS811_MODE_250MS are read with 
+// read_raw(): then only `raw` is set, eco2 and etvoc are 0, and errstat is 0 or CCS811_ERRSTAT_I2CFAIL.
+// Call poll() repeatedly (e.g. until it returns -1) from loop(); it reads at most one sensor per call.
+int CCS811Manager::poll(uint16_t*eco2, uint16_t*etvoc, uint16_t*errstat, uint16_t*raw) {
+  unsigned long now= millis();
+  int  best= -1;
+  long bestlate= 0;
+  int  bestcost= 0;
+  for( int i=0; i<_count; i++ ) {
+    int mode= _sensors[i]->get_mode();
+    if( mode!=_mode[i] ) {
+      // (Re)started: first sample is due one period from now
+      _mode[i]= mode;
+      _due_ms[i]= now + ccs811manager_period_ms(mode);
+    }
+    if( mode==CCS811_MODE_IDLE ) continue;
+    long late= (long)(now-_due_ms[i]);
+    if( late<0 ) continue;
+    if( !_sensors[i]->data_ready() ) continue;
+    int cost= _sensors[i]->get_bus()->switch_cost();
+    if( best<0 || cost<bestcost || (cost==bestcost && late>bestlate) ) { best= i; bestlate= late; bestcost= cost; }
+  }
+  if( best<0 ) return -1;
+
+  // Read the sensor
+  CCS811 * ccs811= _sensors[best];
+  unsigned long period= ccs811manager_period_ms(_mode[best]);
+  if( _mode[best]==CCS811_MODE_250MS ) {
+    uint16_t r= 0;
+    bool ok= ccs811->read_raw(&r);
+    if( eco2   ) *eco2= 0;
+    if( etvoc  ) *etvoc= 0;
+    if( errstat) *errstat= ok ? 0 : CCS811_ERRSTAT_I2CFAIL;
+    if( raw    ) *raw= ok ? r : 0;
+    _due_ms[best]= now + period;
+  } else {
+    uint16_t es;
+    ccs811->read(eco2,etvoc,&es,raw);
+    if( errstat ) *errstat= es;
+    // Not yet a sample (sensor clock is slower than ours): retry soon, otherwise wait a full period
+    if( (es & (CCS811_ERRSTAT_DATA_READY|CCS811_ERRSTAT_ERRORS))==0 ) _due_ms[best]= now + period/CCS811MANAGER_RETRY_DIV;
+    else _due_ms[best]= now + period;
+  }
+  return best;
+}
+
+
+// Waits `us` (also more than delayMicroseconds supports)
+static void ccs811manager_wait_us(unsigned long us) {
+  if( us>=1000 ) delay(us/1000);
+  if( us%1000>0 ) delayMicroseconds(us%1000);
+}
+
+
+// The sensors being flashed are a bit mask of one byte
+static_assert( CCS811MANAGER_MAX<=8, "CCS811Manager::flash() keeps a bit per sensor in a uint8_t" );
+
+
+// Flashes all sensors with `size` bytes of `image` (PROGMEM) in parallel. Returns the number of sensors flashed successfully.
+// The flashes are interleaved: while one sensor processes a block, the others get theirs. 
+// So flashing N sensors takes about as long as flashing one. Afterwards, call begin() (and start()) of each sensor.
+int CCS811Manager::flash(const uint8_t * image, int size, CCS811FlashProgress progress) {
+  uint8_t busy= 0;
+  int     done= 0;
+  for( int i=0; i<_count; i++ ) {
+    if( _sensors[i]->flash_begin(image,size,progress) ) busy|= 1<<i;
+  }
+  while( busy ) {
+    // Give each sensor that is ready its next step, and find the shortest wait of the others
+    unsigned long wait_us= 0xFFFFFFFFUL;
+    for( int i=0; i<_count; i++ ) {
+      if( (busy & (1<<i))==0 ) continue;
+      int res= _sensors[i]->flash_poll();
+      if( res!=CCS811_FLASH_BUSY ) {
+        busy&= ~(1<<i);
+        if( res==CCS811_FLASH_DONE ) done++;
+        continue;
+      }
+      unsigned long w= _sensors[i]->flash_wait_us();
+      if( w<wait_us ) wait_us= w;
+    }
+    if( busy ) ccs811manager_wait_us(wait_us);
+  }
+  return done;
+}
+
+
+// The sensors still to write are a bit mask of one byte
+static_assert( CCS811MANAGER_MAX<=8, "CCS811Manager::set_envdata() keeps a bit per sensor in a uint8_t" );
+
+
+// Writes t and h (CCS811 format) to ENV_DATA of all sensors. Returns the number of sensors written successfully.
+// The writes are grouped by bus: each next sensor is one that needs no bus switch (e.g. on the mux channel that is
+// selected), else the first one left. So sensors behind a mux cost one channel select per channel, not per sensor.
+// Each sensor's dead-band (see CCS811::set_envdata_deadband) still applies; a skipped write counts as successful.
+int CCS811Manager::set_envdata(uint16_t t, uint16_t h) {
+  uint8_t todo= (1<<_count)-1;
+  int     done= 0;
+  while( todo ) {
+    int next= -1;
+    for( int i=0; i<_count; i++ ) {
+      if( (todo & (1<<i))==0 ) continue;
+      if( next<0 ) next= i;
+      if( _sensors[i]->get_bus()->switch_cost()==0 ) { next= i; break; }
+    }
+    todo&= ~(1<<next);
+    if( _sensors[next]->set_envdata(t,h) ) done++;
+  }
+  return done;
+}
+
+
+// As set_envdata, but t and h in ENS210 format (see CCS811::set_envdata210); converted once for all sensors.
+int CCS811Manager::set_envdata210(uint16_t t, uint16_t h) {
+  return set_envdata( CCS811::envdata_t_ens210(t), h );
+}
+
+
+// As set_envdata, but t in milli Celsius and h in milli %RH (see CCS811::set_envdata_mCelsius_mpercRH); converted once for all sensors.
+int CCS811Manager::set_envdata_mCelsius_mpercRH(int32_t t, int32_t h) {
+  return set_envdata( CCS811::envdata_t_mCelsius(t), CCS811::envdata_h_mpercRH(h) );
+}
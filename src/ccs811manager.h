@@ -0,0 +1,46 @@
+/*
+  ccs811manager.h - Schedules the reads of several CCS811 sensors, so that each is only read when its next sample is due.
+  2026 oct 17  v7  static_assert on CCS811MANAGER_MAX for the set_envdata() bit mask
+  2026 oct 17  v6  static_assert on CCS811MANAGER_MAX for the flash() bit mask
+  2026 oct 17  v5  poll() returns raw 0 when read_raw fails
+  2026 oct 17  v4  Added ENV_DATA fan-out (one T/H source to all sensors)
+  2026 oct 17  v3  Added parallel flash
+  2026 oct 17  v2  Reads are grouped by bus (mux channel)
+  2026 oct 17  v1  Created
+*/
+#ifndef _CCS811MANAGER_H_
+#define _CCS811MANAGER_H_
+
+
+#include <stdint.h>
+#include "ccs811.h"
+
+
+// Maximum number of sensors of one manager
+#define CCS811MANAGER_MAX                  8
+
+
+// A sensor that has no sample yet (no DATA_READY) when it was due, is retried after 1/CCS811MANAGER_RETRY_DIV of its period
+#define CCS811MANAGER_RETRY_DIV            16
+
+
+class CCS811Manager {
+  public:
+    CCS811Manager();
+    int  add(CCS811 * ccs811);                                                // Adds a sensor (it may be on any bus or address, begin() and start() are still called by the caller). Returns its index, or -1 when full.
+    int  count(void);                                                         // Returns the number of sensors added.
+    CCS811 * sensor(int index);                                               // Returns the sensor with `index` (or NULL).
+    int  poll(uint16_t*eco2, uint16_t*etvoc, uint16_t*errstat, uint16_t*raw); // Reads the (most overdue) sensor whose sample is due, preferring the selected mux channel. Returns its index, args set as by read(); or -1 when none is due (no I2C).
+    int  flash(const uint8_t * image, int size, CCS811FlashProgress progress=0); // Flashes all sensors with `size` bytes of `image` (PROGMEM), interleaved, so in about the time of one. Returns the number of sensors flashed successfully.
+    int  set_envdata(uint16_t t, uint16_t h);                                 // Writes t and h (CCS811 format) to ENV_DATA of all sensors, grouped by bus (mux channel). Returns the number of sensors written successfully.
+    int  set_envdata210(uint16_t t, uint16_t h);                              // As set_envdata, but t and h in ENS210 format; converted once for all sensors.
+    int  set_envdata_mCelsius_mpercRH(int32_t t, int32_t h);                  // As set_envdata, but t in milli Celsius and h in milli %RH; converted once for all sensors.
+  private:
+    CCS811 *      _sensors[CCS811MANAGER_MAX];                                // The added sensors.
+    uint8_t       _mode[CCS811MANAGER_MAX];                                   // Mode of each sensor when its deadline was set (to detect a new start()).
+    unsigned long _due_ms[CCS811MANAGER_MAX];                                 // Time (millis) the next sample of each sensor is due.
+    int           _count;
+};
+
+
+#endif
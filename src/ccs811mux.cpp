@@ -0,0 +1,137 @@
+/*
+  ccs811mux.cpp - CCS811 behind a TCA9548A-style I2C multiplexer, with a cache of the selected channel.
+  The CCS811 has only two slave addresses, so more than two sensors on one bus need a mux.
+  2026 oct 17  v3  fetch() that continues a select() no longer switches the channel
+  2026 oct 17  v2  No default Wire bus with CCS811_NO_WIRE
+  2026 oct 17  v1  Created
+*/
+
+
+#include <Arduino.h>
+#ifndef CCS811_NO_WIRE
+#include <Wire.h>
+#endif
+#include "ccs811mux.h"
+
+
+// Mux ================================================================================================================
+
+
+#ifndef CCS811_NO_WIRE
+// The transport of the mux when the constructor gets none
+static CCS811WireBus ccs811mux_wirebus(Wire);
+#endif
+
+
+// The bus the mux is on (0 for Wire), its slave address, and whether to skip selecting the channel that is already selected.
+CCS811Mux::CCS811Mux(CCS811Bus * bus, int slaveaddr, bool cache) {
+#ifndef CCS811_NO_WIRE
+  _bus= bus ? bus : &ccs811mux_wirebus;
+#else
+  _bus= bus;
+#endif
+  _slaveaddr= slaveaddr;
+  _cache= cache;
+  _selected= -1;
+  _writes= 0;
+}
+
+
+// Selects `channel` (writes the control register, unless cached). Returns false on I2C problems.
+// The TCA9548A has a single control register, without address: its one byte is sent where a register address would be.
+bool CCS811Mux::select(int channel) {
+  if( _cache && _selected==channel ) return true;
+  _writes++;
+  bool ok= _bus->write(_slaveaddr,1<<channel,0,0);
+  _selected= ok ? channel : -1;
+  return ok;
+}
+
+
+// Returns the selected channel (-1 when unknown).
+int CCS811Mux::selected(void) {
+  return _selected;
+}
+
+
+// Forgets the selected channel (e.g. after a reset of the mux); the next select() writes.
+void CCS811Mux::invalidate(void) {
+  _selected= -1;
+}
+
+
+// Returns the slave address of the mux.
+int CCS811Mux::slaveaddr(void) {
+  return _slaveaddr;
+}
+
+
+// Returns the bus the mux is on.
+CCS811Bus * CCS811Mux::bus(void) {
+  return _bus;
+}
+
+
+// Returns the number of control register writes so far.
+uint32_t CCS811Mux::writes(void) {
+  return _writes;
+}
+
+
+// Mux bus ============================================================================================================
+
+
+// The (shared) mux and the channel the CCS811 is on.
+CCS811MuxBus::CCS811MuxBus(CCS811Mux * mux, int channel) {
+  _mux= mux;
+  _channel= channel;
+  _selecting= false;
+}
+
+
+// Returns the mux.
+CCS811Mux * CCS811MuxBus::mux(void) {
+  return _mux;
+}
+
+
+// Returns the channel.
+int CCS811MuxBus::channel(void) {
+  return _channel;
+}
+
+
+bool CCS811MuxBus::write(int slaveaddr, int regaddr, int count, const uint8_t * buf) {
+  _selecting= false;
+  return _mux->select(_channel) && _mux->bus()->write(slaveaddr,regaddr,count,buf);
+}
+
+
+bool CCS811MuxBus::select(int slaveaddr, int regaddr) {
+  _selecting= _mux->select(_channel) && _mux->bus()->select(slaveaddr,regaddr);
+  return _selecting;
+}
+
+
+// A fetch() that continues a select() (the repeated START read) must not write the mux: that would land between the two halves.
+// It fails when another channel was selected in between (e.g. by an interleaved read_begin() of a sensor on another channel).
+// A fetch() on its own (the mailbox was still selected) is a transfer of its own, and selects the channel as usual.
+bool CCS811MuxBus::fetch(int slaveaddr, int count, uint8_t * buf) {
+  bool continues= _selecting;
+  _selecting= false;
+  if( continues ) { if( _mux->selected()!=_channel ) return false; }
+  else if( !_mux->select(_channel) ) return false;
+  return _mux->bus()->fetch(slaveaddr,count,buf);
+}
+
+
+bool CCS811MuxBus::read(int slaveaddr, int regaddr, int count, uint8_t * buf, int delay_us) {
+  _selecting= false;
+  return _mux->select(_channel) && _mux->bus()->read(slaveaddr,regaddr,count,buf,delay_us);
+}
+
+
+// 1 when the mux is on another channel, 0 otherwise.
+int CCS811MuxBus::switch_cost(void) {
+  return _mux->selected()==_channel ? 0 : 1;
+}
@@ -0,0 +1,62 @@
+/*
+  ccs811mux.h - CCS811 behind a TCA9548A-style I2C multiplexer, with a cache of the selected channel.
+  The CCS811 has only two slave addresses, so more than two sensors on one bus need a mux.
+  2026 oct 17  v3  fetch() that continues a select() no longer switches the channel
+  2026 oct 17  v2  No default Wire bus with CCS811_NO_WIRE
+  2026 oct 17  v1  Created
+*/
+#ifndef _CCS811MUX_H_
+#define _CCS811MUX_H_
+
+
+#include <stdint.h>
+#include "ccs811.h"
+
+
+// The slave address of a TCA9548A with A2..A0 tied to GND (up to 0x77)
+#define CCS811MUX_SLAVEADDR                0x70
+
+
+// Number of channels of a TCA9548A
+#define CCS811MUX_CHANNELS                 8
+
+
+// A multiplexer; shared by the CCS811MuxBus of all sensors behind it. It remembers the selected channel.
+class CCS811Mux {
+  public:
+    CCS811Mux(CCS811Bus * bus=0, int slaveaddr=CCS811MUX_SLAVEADDR, bool cache=true); // The bus the mux is on (0 for Wire, required with CCS811_NO_WIRE), its slave address, and whether to skip selecting the channel that is already selected (pass false when another master also switches the mux).
+    bool select(int channel);                                                 // Selects `channel` (writes the control register, unless cached). Returns false on I2C problems.
+    int  selected(void);                                                      // Returns the selected channel (-1 when unknown).
+    void invalidate(void);                                                    // Forgets the selected channel (e.g. after a reset of the mux); the next select() writes.
+    int  slaveaddr(void);                                                     // Returns the slave address of the mux.
+    CCS811Bus * bus(void);                                                    // Returns the bus the mux is on.
+    uint32_t writes(void);                                                    // Returns the number of control register writes so far.
+  private:
+    CCS811Bus * _bus;
+    int      _slaveaddr;
+    bool     _cache;
+    int      _selected;
+    uint32_t _writes;
+};
+
+
+// The transport of one CCS811 behind a mux: selects its channel before each transfer.
+class CCS811MuxBus : public CCS811Bus {
+  public:
+    CCS811MuxBus(CCS811Mux * mux, int channel);                              // The (shared) mux and the channel the CCS811 is on.
+    CCS811Mux * mux(void);                                                    // Returns the mux.
+    int  channel(void);                                                       // Returns the channel.
+  public: // CCS811Bus
+    virtual bool write(int slaveaddr, int regaddr, int count, const uint8_t * buf);
+    virtual bool select(int slaveaddr, int regaddr);
+    virtual bool fetch(int slaveaddr, int count, uint8_t * buf);              // After select(): does not switch the channel, fails when it is no longer the one of the select().
+    virtual bool read(int slaveaddr, int regaddr, int count, uint8_t * buf, int delay_us);
+    virtual int  switch_cost(void);                                           // 1 when the mux is on another channel, 0 otherwise.
+  private:
+    CCS811Mux * _mux;
+    bool        _selecting;                                                   // A select() awaits its fetch()
+    int         _channel;
+};
+
+
+#endif
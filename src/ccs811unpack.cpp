@@ -0,0 +1,90 @@
+/*
+  ccs811unpack.cpp - Unpacks a packed CCS811 firmware image (see hex.py --pack), block by block, into flash().
+  The images are encrypted, so they do not compress on their own. But versions share long runs,
+  so an image packed against a reference image (another version also in PROGMEM) is less than half its size.
+  2026 oct 17  v1  Created
+*/
+
+
+#include <Arduino.h>
+#include "ccs811unpack.h"
+
+
+// Unpack =============================================================================================================
+
+
+// The packed image (`packedsize` bytes), and the image it was packed against (if any, `referencesize` bytes); all in PROGMEM.
+CCS811Unpack::CCS811Unpack(const uint8_t * packed, int packedsize, const uint8_t * reference, int referencesize) {
+  _packed= packed;
+  _packedsize= packedsize;
+  _reference= reference;
+  _referencesize= reference ? referencesize : 0;
+  _header= 0;
+  rewind();
+}
+
+
+// Prepends a container header (PROGMEM, CCS811_IMAGE_HEADER_SIZE bytes), so that reader() serves a container for flash_image().
+void CCS811Unpack::set_header(const uint8_t * header) {
+  _header= header;
+  rewind();
+}
+
+
+// Restarts unpacking at the first byte.
+void CCS811Unpack::rewind(void) {
+  _pos= 0;
+  _src= 0;
+  _literals= 0;
+  _copies= 0;
+  _ref= 0;
+}
+
+
+// Unpacks the next `len` bytes into `buf`. Returns the number of bytes unpacked (less at the end, or on a corrupt image).
+int CCS811Unpack::read(uint8_t * buf, int len) {
+  int headersize= _header ? CCS811_IMAGE_HEADER_SIZE : 0;
+  int n= 0;
+  while( n<len ) {
+    if( _pos<headersize ) {
+      buf[n++]= pgm_read_byte(_header+_pos);
+    } else if( _literals>0 ) {
+      if( _src>=_packedsize ) break; // Corrupt: literals beyond the end
+      buf[n++]= pgm_read_byte(_packed+_src++);
+      _literals--;
+    } else if( _copies>0 ) {
+      if( _ref>=_referencesize ) break; // Corrupt: copy beyond the reference
+      buf[n++]= pgm_read_byte(_reference+_ref++);
+      _copies--;
+    } else {
+      // Next token
+      if( _src>=_packedsize ) break; // End
+      uint8_t t= pgm_read_byte(_packed+_src++);
+      if( t<0x80 ) {
+        _literals= t+1;
+      } else {
+        if( _src+2>_packedsize ) break; // Corrupt: truncated token
+        _copies= (t&0x7F)+CCS811UNPACK_MINCOPY;
+        _ref= (pgm_read_byte(_packed+_src)<<8) + pgm_read_byte(_packed+_src+1);
+        _src+= 2;
+      }
+      continue;
+    }
+    _pos++;
+  }
+  return n;
+}
+
+
+// CCS811FlashReader, with `context` a CCS811Unpack. Reading from an earlier `pos` rewinds (and unpacks up to `pos`).
+// So flash_image() may read the container twice (checksum, flash), and the RAM use stays constant.
+int CCS811Unpack::reader(void * context, uint8_t * buf, int pos, int len) {
+  CCS811Unpack * unpack= (CCS811Unpack*)context;
+  if( pos<unpack->_pos ) unpack->rewind();
+  while( unpack->_pos<pos ) {
+    int skip= pos-unpack->_pos;
+    if( skip>len ) skip= len;
+    if( unpack->read(buf,skip)!=skip ) return 0;
+  }
+  return unpack->read(buf,len);
+}
@@ -0,0 +1,43 @@
+/*
+  ccs811unpack.h - Unpacks a packed CCS811 firmware image (see hex.py --pack), block by block, into flash().
+  The images are encrypted, so they do not compress on their own. But versions share long runs,
+  so an image packed against a reference image (another version also in PROGMEM) is less than half its size.
+  2026 oct 17  v1  Created
+*/
+#ifndef _CCS811UNPACK_H_
+#define _CCS811UNPACK_H_
+
+
+#include <stdint.h>
+#include "ccs811.h"
+
+
+// Packed format: a sequence of tokens, each starting with a byte t
+//   t < 0x80   t+1 literal bytes follow
+//   t >= 0x80  copy (t&0x7F)+CCS811UNPACK_MINCOPY bytes from the reference image, at the offset in the next 2 bytes (big endian)
+#define CCS811UNPACK_MINCOPY               4
+
+
+// Unpacks an image (packed and reference image in PROGMEM), using a few bytes of RAM (no window).
+class CCS811Unpack {
+  public:
+    CCS811Unpack(const uint8_t * packed, int packedsize, const uint8_t * reference=0, int referencesize=0); // The packed image, and the image it was packed against (if any).
+    void set_header(const uint8_t * header);                                  // Prepends a container header (PROGMEM, CCS811_IMAGE_HEADER_SIZE bytes), so that reader() serves a container for flash_image().
+    void rewind(void);                                                        // Restarts unpacking at the first byte.
+    int  read(uint8_t * buf, int len);                                        // Unpacks the next `len` bytes into `buf`. Returns the number of bytes unpacked (less at the end, or on a corrupt image).
+    static int reader(void * context, uint8_t * buf, int pos, int len);       // CCS811FlashReader, with `context` a CCS811Unpack. Reading from an earlier `pos` rewinds (and unpacks up to `pos`).
+  private:
+    const uint8_t * _packed;
+    int      _packedsize;
+    const uint8_t * _reference;
+    int      _referencesize;
+    const uint8_t * _header;
+    int      _pos;                                                            // Position in the unpacked output (including the header)
+    int      _src;                                                            // Position in _packed of the next token or literal
+    uint8_t  _literals;                                                       // Literal bytes left in the current token
+    uint8_t  _copies;                                                         // Reference bytes left in the current token
+    int      _ref;                                                            // Position in _reference of the next copied byte
+};
+
+
+#endif